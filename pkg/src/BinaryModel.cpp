@@ -0,0 +1,205 @@
+#include "BinaryModel.h"
+#include <cstring>
+#include <typeinfo>
+
+using namespace std;
+
+namespace
+{
+const char MAGIC[4] = {'C', 'R', 'U', 'L'};
+
+enum OperatorCode
+{
+    EQUALITY,
+    LESS_THAN,
+    GREATER_THAN,
+    LESS_EQUAL,
+    GREATER_EQUAL,
+    INEQUALITY
+};
+}
+
+/**
+ * Encodes rules into the binary representation
+ * @param rules rules to be encoded
+ * @param ds data set the rules were generated for
+ * @return binary representation of the rules
+ */
+vector<unsigned char> BinaryModel::encode(list<Rule>& rules, DataSet& ds)
+{
+    vector<unsigned char> out;
+    uint32_t attCount = ds.getAttributes().size() - 1;
+    out.reserve(sizeof(MAGIC) + 10 + 5 * attCount + rules.size() * 64);
+    for (unsigned int i = 0; i < sizeof(MAGIC); i++)
+        out.push_back(MAGIC[i]);
+    writeUInt16(out, VERSION);
+    writeUInt32(out, attCount);
+    for (uint32_t i = 0; i < attCount; i++)
+    {
+        writeUInt8(out, ds.getConditionalAttribute(i).getType());
+        writeUInt32(out, ds.getConditionalAttribute(i).getLevels().size());
+    }
+    writeUInt32(out, rules.size());
+    for (list<Rule>::iterator itRule = rules.begin(); itRule != rules.end(); itRule++)
+    {
+        vector<list<ElementaryCondition> >& conditions = itRule->getConditions();
+        uint32_t condCount = 0;
+        for (unsigned int i = 0; i < conditions.size(); i++)
+            condCount += conditions[i].size();
+
+        writeDouble(out, itRule->getDecisionClass());
+        writeDouble(out, itRule->getConfidenceDegree());
+        writeUInt32(out, condCount);
+        for (unsigned int i = 0; i < conditions.size(); i++)
+        {
+            for (list<ElementaryCondition>::iterator itCond = conditions[i].begin(); itCond != conditions[i].end(); itCond++)
+            {
+                writeUInt32(out, itCond->getAttributeIndex());
+                writeUInt8(out, getOperatorCode(itCond->getOperator()));
+                writeDouble(out, itCond->getAttributeValue());
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * Decodes rules from the binary representation
+ * @param data binary representation of the rules
+ * @param size size of the representation in bytes
+ * @param ds data set the rules will be applied to; it has to have the same conditional attributes
+ * as the data set the rules were generated for
+ * @return decoded rules
+ */
+list<Rule> BinaryModel::decode(const unsigned char* data, size_t size, DataSet& ds) throw (RulesInductionException)
+{
+    if (size < sizeof(MAGIC) || memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+        throw RulesInductionException("Wrong format of the binary model");
+    Reader reader(data + sizeof(MAGIC), size - sizeof(MAGIC));
+    uint16_t version = reader.readUInt16();
+    if (version == 0 || version > VERSION)
+        throw RulesInductionException("Unsupported version of the binary model");
+
+    uint32_t attCount = reader.readUInt32();
+    if (attCount != ds.getAttributes().size() - 1)
+        throw RulesInductionException("Attributes in the binary model do not match the data set");
+    for (uint32_t i = 0; i < attCount; i++)
+    {
+        uint8_t type = reader.readUInt8();
+        uint32_t levelsCount = reader.readUInt32();
+        if (type != ds.getConditionalAttribute(i).getType() || levelsCount != ds.getConditionalAttribute(i).getLevels().size())
+            throw RulesInductionException("Attributes in the binary model do not match the data set");
+    }
+
+    double classCount = ds.getDecisionAttribute().getLevels().size();
+    list<Rule> rules;
+    uint32_t rulesCount = reader.readUInt32();
+    for (uint32_t i = 0; i < rulesCount; i++)
+    {
+        Rule rule(attCount);
+        double decisionClass = reader.readDouble();
+        if (!(decisionClass >= 0 && decisionClass < classCount))
+            throw RulesInductionException("Wrong decision class in the binary model");
+        rule.setDecisionClass(decisionClass);
+        rule.setConfidenceDegree(reader.readDouble());
+        uint32_t condCount = reader.readUInt32();
+        for (uint32_t j = 0; j < condCount; j++)
+        {
+            uint32_t attIndex = reader.readUInt32();
+            if (attIndex >= attCount)
+                throw RulesInductionException("Wrong attribute index in the binary model");
+            uint8_t code = reader.readUInt8();
+            double value = reader.readDouble();
+            ElementaryCondition cond(attIndex, createOperator(code), value);
+            rule.addCondition(cond);
+        }
+        rules.push_back(std::move(rule));
+    }
+    if (!reader.isAtEnd())
+        throw RulesInductionException("Wrong format of the binary model");
+    return rules;
+}
+
+void BinaryModel::writeUInt16(vector<unsigned char>& out, uint16_t value)
+{
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+}
+
+void BinaryModel::writeUInt32(vector<unsigned char>& out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        out.push_back((value >> (8 * i)) & 0xFF);
+}
+
+void BinaryModel::writeDouble(vector<unsigned char>& out, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++)
+        out.push_back((bits >> (8 * i)) & 0xFF);
+}
+
+uint8_t BinaryModel::getOperatorCode(RelationalOperator* op)
+{
+    if (typeid(*op) == typeid(EqualityOperator)) return EQUALITY;
+    if (typeid(*op) == typeid(LessThanOperator)) return LESS_THAN;
+    if (typeid(*op) == typeid(GreaterThanOperator)) return GREATER_THAN;
+    if (typeid(*op) == typeid(LessEqualOperator)) return LESS_EQUAL;
+    if (typeid(*op) == typeid(GreaterEqualOperator)) return GREATER_EQUAL;
+    return INEQUALITY;
+}
+
+RelationalOperator* BinaryModel::createOperator(uint8_t code) throw (RulesInductionException)
+{
+    switch (code)
+    {
+    case EQUALITY: return new EqualityOperator();
+    case LESS_THAN: return new LessThanOperator();
+    case GREATER_THAN: return new GreaterThanOperator();
+    case LESS_EQUAL: return new LessEqualOperator();
+    case GREATER_EQUAL: return new GreaterEqualOperator();
+    case INEQUALITY: return new InequalityOperator();
+    }
+    throw RulesInductionException("Wrong operator code in the binary model");
+}
+
+const unsigned char* BinaryModel::Reader::next(size_t bytes)
+{
+    if (size - position < bytes)
+        throw RulesInductionException("Binary model is truncated");
+    const unsigned char* ptr = data + position;
+    position += bytes;
+    return ptr;
+}
+
+uint8_t BinaryModel::Reader::readUInt8()
+{
+    return *next(1);
+}
+
+uint16_t BinaryModel::Reader::readUInt16()
+{
+    const unsigned char* ptr = next(2);
+    return ptr[0] | (ptr[1] << 8);
+}
+
+uint32_t BinaryModel::Reader::readUInt32()
+{
+    const unsigned char* ptr = next(4);
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--)
+        value = (value << 8) | ptr[i];
+    return value;
+}
+
+double BinaryModel::Reader::readDouble()
+{
+    const unsigned char* ptr = next(8);
+    uint64_t bits = 0;
+    for (int i = 7; i >= 0; i--)
+        bits = (bits << 8) | ptr[i];
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
@@ -0,0 +1,60 @@
+#ifndef BINARYMODEL_H
+#define	BINARYMODEL_H
+
+#include <list>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+#include "Rule.h"
+#include "DataSet.h"
+#include "RulesInductionException.h"
+
+/**
+ * Compact binary representation of a rule set. Contains exact values of thresholds
+ * and confidence degrees and indices of attributes, so the rules can be restored without
+ * parsing their text representation. All numbers are stored in little-endian byte order.
+ *
+ * Layout (version 1):
+ * - header: magic "CRUL", version (uint16), number of conditional attributes (uint32),
+ *   for every conditional attribute: type (uint8) and number of levels (uint32),
+ *   number of rules (uint32)
+ * - for every rule: decision class (double), confidence degree (double), number of conditions (uint32)
+ * - for every condition: attribute index (uint32), operator code (uint8), value (double)
+ */
+class BinaryModel
+{
+public:
+    static const uint16_t VERSION = 1;
+
+    static std::vector<unsigned char> encode(std::list<Rule>& rules, DataSet& ds);
+    static std::list<Rule> decode(const unsigned char* data, std::size_t size, DataSet& ds) throw (RulesInductionException);
+private:
+    static void writeUInt8(std::vector<unsigned char>& out, uint8_t value) { out.push_back(value); }
+    static void writeUInt16(std::vector<unsigned char>& out, uint16_t value);
+    static void writeUInt32(std::vector<unsigned char>& out, uint32_t value);
+    static void writeDouble(std::vector<unsigned char>& out, double value);
+    static uint8_t getOperatorCode(RelationalOperator* op);
+    static RelationalOperator* createOperator(uint8_t code) throw (RulesInductionException);
+
+    /**
+     * Reads values from the binary representation and checks its bounds
+     */
+    class Reader
+    {
+    public:
+        Reader(const unsigned char* data, std::size_t size) : data(data), size(size), position(0) {}
+        uint8_t readUInt8();
+        uint16_t readUInt16();
+        uint32_t readUInt32();
+        double readDouble();
+        bool isAtEnd() const { return position == size; }
+    private:
+        const unsigned char* next(std::size_t bytes);
+        const unsigned char* data;
+        std::size_t size;
+        std::size_t position;
+    };
+};
+
+#endif	/* BINARYMODEL_H */
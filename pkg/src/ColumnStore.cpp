@@ -0,0 +1,246 @@
+#include "ColumnStore.h"
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+ColumnStore::ColumnStore() : numberOfSparseColumns(0), maxSparseDensity(0), singlePrecision(false), rows(0), memoryBudget(numeric_limits<size_t>::max()), memoryUsage(0),
+    spillFile(-1), spillSize(0)
+{
+}
+
+ColumnStore::~ColumnStore()
+{
+    for (size_t i = 0; i < memoryColumns.size(); i++)
+        delete [] memoryColumns[i];
+    for (size_t i = 0; i < sparseColumns.size(); i++)
+        delete sparseColumns[i];
+#ifndef _WIN32
+    for (size_t i = 0; i < mappings.size(); i++)
+        munmap(mappings[i].address, mappings[i].length);
+    if (spillFile != -1)
+        close(spillFile);
+#endif
+}
+
+/**
+ * Adds a column of the type chosen for its values
+ * @param values values of the attribute for all the examples
+ * @param numerical true for numerical attributes (the column may be sparse), false for codes of nominal ones
+ */
+void ColumnStore::addColumn(const vector<double>& values, bool numerical) throw (RulesInductionException)
+{
+    if (!columns.empty() && values.size() != rows)
+        throw RulesInductionException("Inconsistent input data");
+    rows = values.size();
+    if (numerical && maxSparseDensity > 0 && !values.empty())
+    {
+        size_t others;
+        double defaultValue = SparseColumn::chooseDefaultValue(&values[0], rows, others);
+        if (others < maxSparseDensity * rows)
+        {
+            addSparseColumn(new SparseColumn(&values[0], rows, defaultValue));
+            return;
+        }
+    }
+
+    ColumnType type = chooseType(values, numerical);
+    switch (type)
+    {
+        case FLOAT_COLUMN:
+            columns.push_back(addConvertedColumn(values, numeric_limits<float>::quiet_NaN()));
+            break;
+        case INT_COLUMN:
+            columns.push_back(addConvertedColumn(values, numeric_limits<int>::min()));
+            break;
+        case SHORT_COLUMN:
+            columns.push_back(addConvertedColumn(values, numeric_limits<unsigned short>::max()));
+            break;
+        case BYTE_COLUMN:
+            columns.push_back(addConvertedColumn(values, numeric_limits<unsigned char>::max()));
+            break;
+        default:
+            columns.push_back(addColumn(values.empty() ? NULL : &values[0], rows * sizeof(double)));
+    }
+    types.push_back(type);
+    sparseColumns.push_back(NULL);
+}
+
+/**
+ * Chooses the narrowest type holding the values exactly (except for single precision)
+ * @param values values of the column
+ * @param numerical true for numerical attributes
+ * @return type of the column
+ */
+ColumnStore::ColumnType ColumnStore::chooseType(const vector<double>& values, bool numerical) const
+{
+    bool integers = true;
+    double minValue = 0, maxValue = 0;
+    for (size_t i = 0; i < values.size() && integers; i++)
+    {
+        double value = values[i];
+        if (value != value)
+            continue;
+        //negative zeros are kept, they are not equal to the stored zeros by sign
+        integers = value == floor(value) && value > numeric_limits<int>::min() && value <= numeric_limits<int>::max()
+                && !(value == 0 && signbit(value));
+        minValue = min(minValue, value);
+        maxValue = max(maxValue, value);
+    }
+    if (!integers)
+        return numerical && singlePrecision ? FLOAT_COLUMN : DOUBLE_COLUMN;
+    if (numerical || minValue < 0)
+        return INT_COLUMN;
+    if (maxValue < numeric_limits<unsigned char>::max())
+        return BYTE_COLUMN;
+    if (maxValue < numeric_limits<unsigned short>::max())
+        return SHORT_COLUMN;
+    return INT_COLUMN;
+}
+
+/**
+ * Adds a column with the values converted to the type T
+ * @param values values of the column
+ * @param missing value stored for missing values
+ * @return address of the column
+ */
+template <class T>
+const void* ColumnStore::addConvertedColumn(const vector<double>& values, T missing) throw (RulesInductionException)
+{
+    vector<T> converted(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+        converted[i] = values[i] != values[i] ? missing : (T)values[i];
+    return addColumn(converted.empty() ? NULL : &converted[0], converted.size() * sizeof(T));
+}
+
+/**
+ * Copies all the columns of another store; the budget and the spill directory of this store are used
+ * @param orig store to be copied
+ */
+void ColumnStore::copyColumns(const ColumnStore& orig) throw (RulesInductionException)
+{
+    rows = orig.rows;
+    for (size_t i = 0; i < orig.columns.size(); i++)
+    {
+        if (orig.isSparse(i))
+        {
+            addSparseColumn(new SparseColumn(*orig.sparseColumns[i]));
+            continue;
+        }
+        columns.push_back(addColumn(orig.columns[i], orig.rows * getValueSize(orig.types[i])));
+        types.push_back(orig.types[i]);
+        sparseColumns.push_back(NULL);
+    }
+}
+
+/**
+ * Adds a sparse column; it is kept in memory regardless of the budget, but counted in the memory usage
+ * @param column column owned by the store from now on
+ */
+void ColumnStore::addSparseColumn(SparseColumn* column)
+{
+    columns.push_back(NULL);
+    types.push_back(SPARSE_COLUMN);
+    sparseColumns.push_back(column);
+    numberOfSparseColumns++;
+    memoryUsage += column->getMemoryUsage();
+}
+
+/**
+ * @param type type of a dense column
+ * @return size of one value of the column in bytes
+ */
+size_t ColumnStore::getValueSize(ColumnType type)
+{
+    switch (type)
+    {
+        case FLOAT_COLUMN: return sizeof(float);
+        case INT_COLUMN: return sizeof(int);
+        case SHORT_COLUMN: return sizeof(unsigned short);
+        case BYTE_COLUMN: return sizeof(unsigned char);
+        default: return sizeof(double);
+    }
+}
+
+const void* ColumnStore::addColumn(const void* values, size_t bytes) throw (RulesInductionException)
+{
+#ifndef _WIN32
+    if (bytes > 0 && (memoryUsage > memoryBudget || bytes > memoryBudget - memoryUsage))
+        return mapColumn(values, bytes);
+#endif
+    //the memory of new char[] is aligned for values of any type
+    char* column = new char[bytes == 0 ? sizeof(double) : bytes];
+    if (bytes > 0)
+        memcpy(column, values, bytes);
+    memoryColumns.push_back(column);
+    memoryUsage += bytes;
+    return column;
+}
+
+#ifndef _WIN32
+/**
+ * Writes the column at the end of the spill file and maps it into memory
+ * @param values values of the column
+ * @param length size of the column in bytes
+ * @return address of the mapped column
+ */
+const void* ColumnStore::mapColumn(const void* values, size_t length) throw (RulesInductionException)
+{
+    if (spillFile == -1)
+        openSpillFile();
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t offset = (spillSize + pageSize - 1) / pageSize * pageSize;  //mapped regions have to start at page boundaries
+
+    const char* data = reinterpret_cast<const char*>(values);
+    size_t written = 0;
+    while (written < length)
+    {
+        ssize_t result = pwrite(spillFile, data + written, length - written, offset + written);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            throw RulesInductionException("Cannot write data to the temporary file: " + string(strerror(errno)));
+        written += result;
+    }
+    spillSize = offset + length;
+
+    void* address = mmap(NULL, length, PROT_READ, MAP_SHARED, spillFile, offset);
+    if (address == MAP_FAILED)
+        throw RulesInductionException("Cannot map the temporary file into memory: " + string(strerror(errno)));
+    Mapping mapping;
+    mapping.address = address;
+    mapping.length = length;
+    mappings.push_back(mapping);
+    return address;
+}
+
+/**
+ * Creates the spill file in the spill directory (or in /tmp); the file is removed at once,
+ * so it disappears when the store is destroyed or the process ends
+ */
+void ColumnStore::openSpillFile() throw (RulesInductionException)
+{
+    string path = (spillDirectory.empty() ? string("/tmp") : spillDirectory) + "/crulesXXXXXX";
+    vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    spillFile = mkstemp(&name[0]);
+    if (spillFile == -1)
+        throw RulesInductionException("Cannot create a temporary file in " + path + ": " + string(strerror(errno)));
+    unlink(&name[0]);
+}
+#else
+const void* ColumnStore::mapColumn(const void* values, size_t length) throw (RulesInductionException)
+{
+    throw RulesInductionException("Memory-mapped data is not supported on this platform");
+}
+
+void ColumnStore::openSpillFile() throw (RulesInductionException)
+{
+}
+#endif
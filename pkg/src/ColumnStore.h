@@ -0,0 +1,124 @@
+#ifndef COLUMNSTORE_H
+#define	COLUMNSTORE_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <limits>
+#include "RulesInductionException.h"
+#include "SparseColumn.h"
+
+/**
+ * Values of the conditional attributes of a data set stored by columns. Columns are kept in memory
+ * until their total size reaches the memory budget; the following ones are written to a temporary
+ * file and memory-mapped, so the system loads their pages on demand and the data set may be larger
+ * than the available memory. Scans of an attribute over examples taken in the order of the data set
+ * read the mapped column sequentially.
+ * Mapping is not available on Windows, there all the columns are kept in memory.
+ * Every column has the narrowest physical type holding its values exactly: integer values are stored
+ * as int, codes of nominal attributes as unsigned char or short and other values as double (or float,
+ * if single precision is allowed); missing values are stored as the greatest code or the least int.
+ * Columns of numerical attributes with few values other than zero (or missing) may be stored
+ * as sparse columns; they are always kept in memory and getColumn() returns NULL for them.
+ */
+class ColumnStore
+{
+public:
+    /** physical types of the columns*/
+    enum ColumnType
+    {
+        DOUBLE_COLUMN,
+        FLOAT_COLUMN,   /**< values of numerical attributes in single precision*/
+        INT_COLUMN,     /**< integer values*/
+        SHORT_COLUMN,   /**< codes of nominal attributes up to 65534*/
+        BYTE_COLUMN,    /**< codes of nominal attributes up to 254*/
+        SPARSE_COLUMN
+    };
+
+    ColumnStore();
+    ~ColumnStore();
+
+    void setMemoryBudget(std::size_t bytes) { memoryBudget = bytes; }
+    std::size_t getMemoryBudget() const { return memoryBudget; }
+    void setSpillDirectory(const std::string& directory) { spillDirectory = directory; }
+    std::string getSpillDirectory() const { return spillDirectory; }
+    /** columns with a lower fraction of values other than the default one are sparse; 0 disables sparse columns*/
+    void setMaxSparseDensity(double density) { maxSparseDensity = density; }
+    double getMaxSparseDensity() const { return maxSparseDensity; }
+    /** values of numerical attributes other than integers are stored in single precision (rounded)*/
+    void setSinglePrecision(bool singlePrecision) { this->singlePrecision = singlePrecision; }
+    bool isSinglePrecision() const { return singlePrecision; }
+    void addColumn(const std::vector<double>& values, bool numerical = true) throw (RulesInductionException);
+    void copyColumns(const ColumnStore& orig) throw (RulesInductionException);
+    ColumnType getType(int index) const { return types[index]; }
+    /** @return values of a dense column of the type T given by getType()*/
+    template <class T>
+    const T* getColumn(int index) const { return static_cast<const T*>(columns[index]); }
+    bool isSparse(int index) const { return types[index] == SPARSE_COLUMN; }
+    const SparseColumn& getSparseColumn(int index) const { return *sparseColumns[index]; }
+    int getNumberOfSparseColumns() const { return numberOfSparseColumns; }
+
+    /**
+     * @param index index of the column
+     * @param row index of the row
+     * @return value of the column in the row
+     */
+    double getValue(int index, std::size_t row) const
+    {
+        switch (types[index])
+        {
+            case DOUBLE_COLUMN: return getColumn<double>(index)[row];
+            case FLOAT_COLUMN: return getColumn<float>(index)[row];
+            case INT_COLUMN: return toDouble(getColumn<int>(index)[row]);
+            case SHORT_COLUMN: return toDouble(getColumn<unsigned short>(index)[row]);
+            case BYTE_COLUMN: return toDouble(getColumn<unsigned char>(index)[row]);
+            default: return sparseColumns[index]->getValue(row);
+        }
+    }
+
+    /** conversions of the stored values, missing values become NaN*/
+    static double toDouble(double value) { return value; }
+    static double toDouble(float value) { return value; }
+    static double toDouble(int value) { return value == std::numeric_limits<int>::min() ? std::numeric_limits<double>::quiet_NaN() : value; }
+    static double toDouble(unsigned short value) { return value == std::numeric_limits<unsigned short>::max() ? std::numeric_limits<double>::quiet_NaN() : value; }
+    static double toDouble(unsigned char value) { return value == std::numeric_limits<unsigned char>::max() ? std::numeric_limits<double>::quiet_NaN() : value; }
+
+    int getNumberOfColumns() const { return columns.size(); }
+    std::size_t getNumberOfRows() const { return rows; }
+    std::size_t getMemoryUsage() const { return memoryUsage; }
+    int getNumberOfMappedColumns() const { return mappings.size(); }
+private:
+    ColumnStore(const ColumnStore&);
+    ColumnStore& operator=(const ColumnStore&);
+    ColumnType chooseType(const std::vector<double>& values, bool numerical) const;
+    template <class T>
+    const void* addConvertedColumn(const std::vector<double>& values, T missing) throw (RulesInductionException);
+    const void* addColumn(const void* values, std::size_t bytes) throw (RulesInductionException);
+    void addSparseColumn(SparseColumn* column);
+    const void* mapColumn(const void* values, std::size_t bytes) throw (RulesInductionException);
+    static std::size_t getValueSize(ColumnType type);
+    void openSpillFile() throw (RulesInductionException);
+
+    struct Mapping
+    {
+        void* address;
+        std::size_t length;
+    };
+
+    std::vector<const void*> columns;       /**< dense columns, NULL for sparse ones*/
+    std::vector<ColumnType> types;
+    std::vector<SparseColumn*> sparseColumns;   /**< sparse columns, NULL for dense ones*/
+    int numberOfSparseColumns;
+    double maxSparseDensity;
+    bool singlePrecision;
+    std::vector<char*> memoryColumns;       /**< columns allocated in memory*/
+    std::vector<Mapping> mappings;          /**< columns mapped from the spill file*/
+    std::size_t rows;
+    std::size_t memoryBudget;               /**< maximal size of the columns kept in memory in bytes*/
+    std::size_t memoryUsage;
+    std::string spillDirectory;
+    int spillFile;                          /**< descriptor of the (already unlinked) spill file, -1 if not opened*/
+    std::size_t spillSize;
+};
+
+#endif	/* COLUMNSTORE_H */
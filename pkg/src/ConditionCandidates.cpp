@@ -0,0 +1,60 @@
+#include "ConditionCandidates.h"
+
+using namespace std;
+
+/**
+ * Removes all candidates; the memory is kept for the next scan
+ */
+void ConditionCandidates::clear()
+{
+    candidates.clear();
+    results.clear();
+}
+
+/**
+ * Adds result of the evaluation of a condition to be evaluated by the rule quality measure
+ * @param result result of the evaluation of the condition
+ * @return index of the result
+ */
+int ConditionCandidates::addResult(const RuleEvaluationResult& result)
+{
+    results.push_back(result);
+    return results.size() - 1;
+}
+
+/**
+ * Adds a candidate
+ * @param value value of the attribute used in the conditions
+ * @param quality quality of the condition ">=" or "=" (used if resultIndex is -1)
+ * @param ltQuality quality of the condition "<" (used if ltResultIndex is -1)
+ * @param resultIndex index of the result (returned by addResult) the quality will be computed from
+ * @param ltResultIndex index of the result (returned by addResult) the ltQuality will be computed from
+ */
+void ConditionCandidates::add(double value, double quality, double ltQuality, int resultIndex, int ltResultIndex)
+{
+    Candidate candidate;
+    candidate.value = value;
+    candidate.quality = quality;
+    candidate.ltQuality = ltQuality;
+    candidate.resultIndex = resultIndex;
+    candidate.ltResultIndex = ltResultIndex;
+    candidates.push_back(candidate);
+}
+
+/**
+ * Computes qualities of the candidates from the collected results by one call of the measure
+ * @param rqm rule quality measure
+ */
+void ConditionCandidates::evaluate(RuleQualityMeasure& rqm)
+{
+    if (results.size() == 0)
+        return;
+    rqm.EvaluateRuleQualityFromResults(results, qualities);
+    for (vector<Candidate>::iterator it = candidates.begin(); it != candidates.end(); it++)
+    {
+        if (it->resultIndex >= 0)
+            it->quality = qualities[it->resultIndex];
+        if (it->ltResultIndex >= 0)
+            it->ltQuality = qualities[it->ltResultIndex];
+    }
+}
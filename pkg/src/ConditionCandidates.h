@@ -0,0 +1,73 @@
+#ifndef CONDITIONCANDIDATES_H
+#define	CONDITIONCANDIDATES_H
+
+#include "RuleEvaluationResult.h"
+#include "RuleQualityMeasure.h"
+#include <vector>
+#include <limits>
+
+/**
+ * Candidate elementary conditions found during a scan of one attribute. Results of the evaluation
+ * of the candidates are collected first and evaluated by one call of the rule quality measure,
+ * then the best conditions are chosen in the order of the scan.
+ * Every candidate has a value (threshold or level of the attribute) and two qualities
+ * (for conditions "attribute >= value" and "attribute < value"; only the first one is used for nominal attributes).
+ */
+class ConditionCandidates
+{
+public:
+    struct Candidate
+    {
+        double value;
+        double quality;     /**< quality of the condition ">=" (or "=" for nominal attributes)*/
+        double ltQuality;   /**< quality of the condition "<"*/
+        int resultIndex;    /**< index of the result used to compute quality, -1 if quality is already known*/
+        int ltResultIndex;  /**< index of the result used to compute ltQuality, -1 if ltQuality is already known*/
+    };
+
+    void clear();
+    int addResult(const RuleEvaluationResult& result);
+    void add(double value, double quality, double ltQuality, int resultIndex = -1, int ltResultIndex = -1);
+    template <class Measure>
+    void addCandidate(Measure& rqm, double value, const RuleEvaluationResult& result, bool useResult,
+            const RuleEvaluationResult& ltResult, bool useLtResult);
+    void evaluate(RuleQualityMeasure& rqm);
+    std::vector<Candidate>& getCandidates() { return candidates; }
+private:
+    std::vector<Candidate> candidates;
+    RuleEvaluationResults results;
+    std::vector<double> qualities;
+};
+
+/**
+ * Adds a candidate and computes its qualities at once. The measure of a known type is called directly,
+ * so its formula is compiled into the scan of the attribute.
+ * @param rqm rule quality measure
+ * @param value value of the attribute used in the conditions
+ * @param result result of the evaluation of the condition ">=" (or "=")
+ * @param useResult false if the condition ">=" (or "=") is not a candidate
+ * @param ltResult result of the evaluation of the condition "<"
+ * @param useLtResult false if the condition "<" is not a candidate
+ */
+template <class Measure>
+inline void ConditionCandidates::addCandidate(Measure& rqm, double value, const RuleEvaluationResult& result, bool useResult,
+        const RuleEvaluationResult& ltResult, bool useLtResult)
+{
+    add(value, useResult ? rqm.Measure::EvaluateRuleQualityFromResult(result) : -std::numeric_limits<double>::max(),
+            useLtResult ? rqm.Measure::EvaluateRuleQualityFromResult(ltResult) : -std::numeric_limits<double>::max());
+}
+
+/**
+ * For a measure of an unknown type (e.g. defined in R) the results are collected
+ * and evaluated by one call of the measure in evaluate()
+ */
+template <>
+inline void ConditionCandidates::addCandidate<RuleQualityMeasure>(RuleQualityMeasure& /*rqm*/, double value,
+        const RuleEvaluationResult& result, bool useResult, const RuleEvaluationResult& ltResult, bool useLtResult)
+{
+    int resultIndex = useResult ? addResult(result) : -1;
+    int ltResultIndex = useLtResult ? addResult(ltResult) : -1;
+    add(value, -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), resultIndex, ltResultIndex);
+}
+
+#endif	/* CONDITIONCANDIDATES_H */
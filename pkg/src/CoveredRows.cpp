@@ -0,0 +1,56 @@
+#include "CoveredRows.h"
+
+using namespace std;
+
+/**
+ * Indexes the covered examples by their rows; positions of the previous examples are cleared,
+ * so only the changed entries are written
+ * @param covered set of examples covered by current rule
+ * @param decClass positive class
+ */
+void CoveredRows::setExamples(SetOfExamples& covered, double decClass)
+{
+    for (size_t j = 0; j < rows.size(); j++)
+        positions[rows[j]] = -1;
+    positions.resize(covered.getDataSet().getExamples().size(), -1);
+    int size = covered.size();
+    rows.resize(size);
+    positiveWeight = negativeWeight = 0;
+    numberOfPositives = 0;
+    for (int j = 0; j < size; j++)
+    {
+        rows[j] = covered.getIndex(j);
+        positions[rows[j]] = j;
+        if (covered[j].getDecisionAttribute() == decClass)
+        {
+            positiveWeight += covered.getWeight(j);
+            numberOfPositives++;
+        }
+        else
+            negativeWeight += covered.getWeight(j);
+    }
+}
+
+/**
+ * Finds the covered examples among the stored values of a sparse column
+ * @param column sparse column of the data set of the covered examples
+ * @param found positions of the covered examples with the indices of their values in the column,
+ * ordered by the positions (output)
+ */
+void CoveredRows::findStoredValues(const SparseColumn& column, vector<pair<int, int> >& found) const
+{
+    const vector<int>& stored = column.getRows();
+    found.clear();
+    bool ordered = true;
+    for (size_t k = 0; k < stored.size(); k++)
+    {
+        int j = positions[stored[k]];
+        if (j < 0)
+            continue;
+        if (!found.empty() && j < found.back().first)
+            ordered = false;
+        found.push_back(make_pair(j, (int)k));
+    }
+    if (!ordered)   //covered examples are in the order of the data set unless they were shuffled
+        sort(found.begin(), found.end());
+}
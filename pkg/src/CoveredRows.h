@@ -0,0 +1,35 @@
+#ifndef COVEREDROWS_H
+#define	COVEREDROWS_H
+
+#include "SetOfExamples.h"
+#include "SparseColumn.h"
+#include <vector>
+#include <utility>
+
+/**
+ * Positions of the covered examples by their rows in the data set. Columns of sparse attributes
+ * are scanned through their stored values only: the covered ones are found by their rows and
+ * the covered examples with the default value are summarized by the weights of all the covered
+ * examples minus the weights of the found ones.
+ */
+class CoveredRows
+{
+public:
+    CoveredRows() : positiveWeight(0), negativeWeight(0), numberOfPositives(0) {}
+    void setExamples(SetOfExamples& covered, double decClass);
+    void findStoredValues(const SparseColumn& column, std::vector<std::pair<int, int> >& found) const;
+    /** @return sum of the weights of the covered positive examples*/
+    double getPositiveWeight() const { return positiveWeight; }
+    /** @return sum of the weights of the covered negative examples*/
+    double getNegativeWeight() const { return negativeWeight; }
+    int getNumberOfPositives() const { return numberOfPositives; }
+    int getNumberOfExamples() const { return rows.size(); }
+private:
+    std::vector<int> positions; /**< position of every row of the data set in the covered examples, -1 if not covered*/
+    std::vector<int> rows;      /**< rows of the covered examples*/
+    double positiveWeight;
+    double negativeWeight;
+    int numberOfPositives;
+};
+
+#endif	/* COVEREDROWS_H */
@@ -0,0 +1,1129 @@
+#include "CoveringEngine.h"
+#include "NoKnowledgePolicy.h"
+#include "PreferencesPolicy.h"
+
+using namespace std;
+
+/**
+ * Generates list of rules for every decision class
+ * @param examples training set on which the induction is based
+ * @param rqmGrow rule qualisty measure used in growth phase
+ * @param rqmPrune rule qualisty measure used in pruning phase
+ * @return ist of rules for every decision class
+ */
+template <class KnowledgePolicy>
+list<Rule> CoveringEngine<KnowledgePolicy>::generateRules(SetOfExamples& examples, RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune)
+{
+    list<Rule> ruleSet;
+    policy.prepare(examples);
+    vector<double> classes = examples.getDistinctClasses();
+    vector<double>::iterator it;
+    for(it = classes.begin(); it != classes.end(); it++)
+    {
+        if (policy.isClassSkipped(*it))
+            continue;
+        list<Rule> rulesForClass(generateRulesForClass(examples, rqmGrow, rqmPrune, *it));
+        ruleSet.splice(ruleSet.end(), rulesForClass);
+    }
+    return ruleSet;
+}
+
+/**
+ * Generates list of rules for every decision class starting from the rules of a previous model (warm start)
+ * @param examples training set on which the induction is based
+ * @param rqmGrow rule qualisty measure used in growth phase
+ * @param rqmPrune rule qualisty measure used in pruning phase
+ * @param initialRules rules the covering starts from
+ * @return still valid initial rules followed by new rules for every decision class
+ */
+template <class KnowledgePolicy>
+list<Rule> CoveringEngine<KnowledgePolicy>::generateRules(SetOfExamples& examples, RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune, list<Rule>& initialRules)
+{
+    list<Rule> ruleSet;
+    policy.prepare(examples);
+    vector<double> classes = examples.getDistinctClasses();
+    vector<double>::iterator it;
+    for(it = classes.begin(); it != classes.end(); it++)
+    {
+        if (policy.isClassSkipped(*it))
+            continue;
+        list<Rule> rulesForClass(generateRulesForClass(examples, rqmGrow, rqmPrune, *it, &initialRules));
+        ruleSet.splice(ruleSet.end(), rulesForClass);
+    }
+    return ruleSet;
+}
+
+/**
+ * Generates list of rules for given decision class. The knowledge has to be prepared by the policy
+ * (it is done by generateRules).
+ * @param examples training set on which the induction is based
+ * @param rqmGrow rule qualisty measure used in growth phase
+ * @param rqmPrune rule qualisty measure used in pruning phase
+ * @param decClass decision class value
+ * @param initialRules rules the covering starts from (NULL - the covering starts from scratch)
+ * @return ist of rules for the decision class
+ */
+template <class KnowledgePolicy>
+list<Rule> CoveringEngine<KnowledgePolicy>::generateRulesForClass(SetOfExamples& examples, RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune, double decClass,
+        list<Rule>* initialRules)
+{
+    AllocationPhase phase(AllocationCounter::COVERING);
+    list<Rule> ruleSet;
+    SetOfExamples uncoveredPositives(examples.getExamplesForDecAtt(decClass));
+    P = uncoveredPositives.getSumOfWeights();
+    N = examples.getSumOfWeights() - P;
+    bool useSpecifiedOnly = policy.isSpecifiedOnly(decClass);
+    int rulesFromSpecifiedConditions = 0;
+    if (!policy.getAllowedRules(decClass).empty())
+        expandAllowedRules(examples, uncoveredPositives, rqmGrow, rqmPrune, decClass, ruleSet, useSpecifiedOnly, rulesFromSpecifiedConditions);
+    if (initialRules != NULL)
+        seedRules(*initialRules, examples, uncoveredPositives, rqmPrune, decClass, ruleSet);
+    if (policy.isCoveringAllowed(decClass))
+        coverPositives(examples, uncoveredPositives, rqmGrow, rqmPrune, decClass, ruleSet, useSpecifiedOnly, rulesFromSpecifiedConditions);
+    return ruleSet;
+}
+
+/**
+ * Adds the allowed rules of the class and tries to improve the expandable ones by the growth and pruning.
+ * Positive examples covered by the fixed and required conditions of the allowed rules are removed from
+ * the uncovered ones.
+ * @param examples training set on which the induction is based
+ * @param uncoveredPositives positive examples not covered by the rules yet
+ * @param rqmGrow rule qualisty measure used in growth phase
+ * @param rqmPrune rule qualisty measure used in pruning phase
+ * @param decClass decision class value
+ * @param ruleSet list the rules are added to
+ * @param useSpecifiedOnly true if only the specified conditions are used; cleared when they do not give good rules
+ * @param rulesFromSpecifiedConditions number of rules made from the specified conditions
+ */
+template <class KnowledgePolicy>
+void CoveringEngine<KnowledgePolicy>::expandAllowedRules(SetOfExamples& examples, SetOfExamples& uncoveredPositives, RuleQualityMeasure& rqmGrow,
+        RuleQualityMeasure& rqmPrune, double decClass, list<Rule>& ruleSet, bool& useSpecifiedOnly, int& rulesFromSpecifiedConditions)
+{
+    double apriori = P / (P + N);
+    Precision precision;
+    RuleEvaluationResult classResult = RuleQualityMeasure::EvaluateClass(examples, decClass);
+    bool isPruneEntropy = typeid (rqmPrune) == typeid (NegConditionalEntropy);
+    list<KnowledgeRule>& allowedRules = policy.getAllowedRules(decClass);
+
+    //insert specified rules to ruleset and compute uncoveredPositives
+    for(list<KnowledgeRule>::iterator it = allowedRules.begin(); it != allowedRules.end(); it++)
+    {
+    	Rule rule(getRuleFromKnowledgeRule(*it, true));	//create rule with only fixed and required conditions to compute uncoveredPositives
+
+    	if(rule.getConditions().size() > 0)
+    	{
+			SetOfExamples covered(getCoveredExamples(rule, examples));
+			uncoveredPositives = uncoveredPositives - covered;
+    	}
+
+    	rule = getRuleFromKnowledgeRule(*it, false);
+
+    	RuleEvaluationResult rer = RuleQualityMeasure::EvaluateRule(examples, rule);
+    	rule.setConfidenceDegree(isPruneEntropy ? rqmPrune.EvaluateRuleQuality(examples, rule) : rqmPrune.EvaluateRuleQualityFromResult(rer));
+    	rule.setEvaluationResult(rer);
+		ruleSet.push_back(std::move(rule));
+    }
+
+    //try to improve specified rules
+    list<KnowledgeRule>::iterator itKnowRule = allowedRules.begin();
+    for(list<Rule>::iterator itRule = ruleSet.begin(); itRule != ruleSet.end() && uncoveredPositives.size() > 0; itRule++, itKnowRule++)
+	{
+    	if(!itKnowRule->getConditions().isExpandable())
+    		continue;	//if not expandable, don't try to improve it
+
+    	pool.reset();
+    	//the rule may be grown on a sample, but it is pruned and evaluated on all the examples
+    	SetOfExamples covered(context.getGrowSampleSize() > 0 ? examples.sampleNegatives(decClass, context.getGrowSampleSize(), context.getRandom()) : examples);
+    	Rule rule(*itRule);
+
+    	//temporarily allow conditions from rule so their "fixed" and "required" properties are respected
+    	policy.allowRuleConditions(decClass, *itKnowRule);
+
+    	growRule(rule, covered, uncoveredPositives, rqmGrow, useSpecifiedOnly);
+    	pruneRule(rule, examples, rqmPrune);
+
+        covered = getCoveredExamples(rule, examples);
+
+        if(precision.EvaluateRuleQuality(covered, *itRule) <= apriori && rulesFromSpecifiedConditions >= policy.getRulesAtLeast(decClass))
+        {
+        	//if adding new rule from the specified conditions will give worse precision than apriori
+        	//then if not "useSpecifiedOnly", start using also other conditions
+        	if(useSpecifiedOnly && !policy.isUseSpecifiedOnly())
+        		useSpecifiedOnly = false;
+        }
+        else
+        {
+			uncoveredPositives = uncoveredPositives - covered;
+			RuleEvaluationResult rer = RuleQualityMeasure::EvaluateCoveredExamples(covered, decClass, classResult);
+			rule.setConfidenceDegree(isPruneEntropy ? rqmPrune.EvaluateRuleQuality(examples, rule) : rqmPrune.EvaluateRuleQualityFromResult(rer));
+			rule.setEvaluationResult(rer);
+			*itRule = std::move(rule);
+			if(useSpecifiedOnly)
+				rulesFromSpecifiedConditions++;
+        }
+
+        policy.disallowRuleConditions(decClass, *itKnowRule);
+	}
+}
+
+/**
+ * Takes the initial rules of the decision class which are still valid on the training set: their precision
+ * is greater than the a priori precision (as of the rules accepted by the covering) and they cover
+ * some positive examples not covered by the rules taken before. Positive examples covered by them
+ * are removed from the uncovered ones.
+ * @param initialRules rules the covering starts from
+ * @param examples training set on which the induction is based
+ * @param uncoveredPositives positive examples not covered by the rules yet
+ * @param rqmPrune rule qualisty measure used in pruning phase (gives confidence degrees)
+ * @param decClass decision class value
+ * @param ruleSet list the rules are added to
+ */
+template <class KnowledgePolicy>
+void CoveringEngine<KnowledgePolicy>::seedRules(list<Rule>& initialRules, SetOfExamples& examples, SetOfExamples& uncoveredPositives,
+        RuleQualityMeasure& rqmPrune, double decClass, list<Rule>& ruleSet)
+{
+    double apriori = P / (P + N);
+    Precision precision;
+    RuleEvaluationResult classResult = RuleQualityMeasure::EvaluateClass(examples, decClass);
+    bool isPruneEntropy = typeid (rqmPrune) == typeid (NegConditionalEntropy);
+    for (list<Rule>::iterator it = initialRules.begin(); it != initialRules.end(); it++)
+    {
+        if (it->getDecisionClass() != decClass)
+            continue;
+        Rule rule(*it);
+        SetOfExamples covered(getCoveredExamples(rule, examples));
+        RuleEvaluationResult rer = RuleQualityMeasure::EvaluateCoveredExamples(covered, decClass, classResult);
+        SetOfExamples stillUncovered(uncoveredPositives - covered);
+        if (stillUncovered.size() == uncoveredPositives.size() || precision.EvaluateRuleQualityFromResult(rer) <= apriori)
+            continue;
+        uncoveredPositives = stillUncovered;
+        rule.setConfidenceDegree(isPruneEntropy ? rqmPrune.EvaluateRuleQuality(examples, rule) : rqmPrune.EvaluateRuleQualityFromResult(rer));
+        rule.setEvaluationResult(rer);
+        ruleSet.push_back(std::move(rule));
+    }
+}
+
+/**
+ * Adds rules for the decision class until all the positive examples are covered
+ * or the precision of a new rule is not greater than the a priori precision
+ * (then the specified conditions are given up first, if other conditions may be used)
+ * @param examples training set on which the induction is based
+ * @param uncoveredPositives positive examples not covered by the rules yet
+ * @param rqmGrow rule qualisty measure used in growth phase
+ * @param rqmPrune rule qualisty measure used in pruning phase
+ * @param decClass decision class value
+ * @param ruleSet list the rules are added to
+ * @param useSpecifiedOnly true if only the specified conditions are used; cleared when they do not give good rules
+ * @param rulesFromSpecifiedConditions number of rules made from the specified conditions
+ */
+template <class KnowledgePolicy>
+void CoveringEngine<KnowledgePolicy>::coverPositives(SetOfExamples& examples, SetOfExamples& uncoveredPositives, RuleQualityMeasure& rqmGrow,
+        RuleQualityMeasure& rqmPrune, double decClass, list<Rule>& ruleSet, bool& useSpecifiedOnly, int& rulesFromSpecifiedConditions)
+{
+    double apriori = P / (P + N);
+    Precision precision;
+    RuleEvaluationResult classResult = RuleQualityMeasure::EvaluateClass(examples, decClass);
+    bool isPruneEntropy = typeid (rqmPrune) == typeid (NegConditionalEntropy);
+
+    while (uncoveredPositives.size() != 0)
+    {
+        pool.reset();
+        //the rule may be grown on a sample, but it is pruned and evaluated on all the examples
+        SetOfExamples covered(context.getGrowSampleSize() > 0 ? examples.sampleNegatives(decClass, context.getGrowSampleSize(), context.getRandom()) : examples);
+        Rule rule;
+        rule.setDecisionClass(decClass);
+        growRule(rule, covered, uncoveredPositives, rqmGrow, useSpecifiedOnly);
+        pruneRule(rule, examples, rqmPrune);
+        //cout << rule.toString((covered.getDataSet())) << endl;
+
+        covered = getCoveredExamples(rule, examples);
+        //covered examples keep the order of the training set, so this is the same as evaluating the rule on the whole set
+        RuleEvaluationResult rer = RuleQualityMeasure::EvaluateCoveredExamples(covered, decClass, classResult);
+
+        if(precision.EvaluateRuleQualityFromResult(rer) <= apriori && rulesFromSpecifiedConditions >= policy.getRulesAtLeast(decClass))
+        {
+        	//cout << "precision < apriori" << endl;
+        	//if not "useSpecifiedOnly" in the knowledge, the rules are built also from other conditions
+        	if(useSpecifiedOnly && !policy.isUseSpecifiedOnly())
+        		useSpecifiedOnly = false;
+        	else
+        		break;
+        }
+        else
+        {
+        	uncoveredPositives = uncoveredPositives - covered;
+        	rule.setConfidenceDegree(isPruneEntropy ? rqmPrune.EvaluateRuleQuality(examples, rule) : rqmPrune.EvaluateRuleQualityFromResult(rer));
+        	rule.setEvaluationResult(rer);
+        	ruleSet.push_back(std::move(rule));
+        	if(useSpecifiedOnly)
+        		rulesFromSpecifiedConditions++;
+        }
+
+        //cout << rule.toString(examples.getDataSet()) << endl;
+    }
+}
+
+/**
+ * Updates rules after new examples were appended to their training set. Counts of the examples covered
+ * by every rule (its evaluation result) are updated with the new examples only and the confidence degree
+ * is computed from them, so the old examples are not scanned. Rules whose quality changed by more than
+ * the threshold are pruned again on the whole training set. Then the covering is continued for the new
+ * positive examples which are not covered by the rules of their class.
+ * @param rules rules induced on the old examples, with their evaluation results
+ * @param examples whole training set (old and new examples)
+ * @param newExamples new examples
+ * @param rqmGrow rule qualisty measure used in growth phase
+ * @param rqmPrune rule qualisty measure used in pruning phase (the one the rules were induced with)
+ * @param repruneThreshold change of the quality of a rule above which the rule is pruned again (infinity - never)
+ * @return updated and new rules of every decision class
+ */
+template <class KnowledgePolicy>
+list<Rule> CoveringEngine<KnowledgePolicy>::updateRules(list<Rule>& rules, SetOfExamples& examples, SetOfExamples& newExamples,
+        RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune, double repruneThreshold) throw (RulesInductionException)
+{
+    AllocationPhase phase(AllocationCounter::COVERING);
+    if (typeid (rqmPrune) == typeid (NegConditionalEntropy))
+        throw RulesInductionException("Rules pruned with the conditional entropy cannot be updated");
+    policy.prepare(examples);
+    list<Rule>::iterator it;
+    for (it = rules.begin(); it != rules.end(); it++)
+    {
+        if (!it->isEvaluated())
+            throw RulesInductionException("Rules cannot be updated without the numbers of examples covered by them");
+        RuleEvaluationResult oldResult = it->getEvaluationResult();
+        RuleEvaluationResult delta = RuleQualityMeasure::EvaluateRule(newExamples, *it);
+        RuleEvaluationResult result(oldResult.P + delta.P, oldResult.p + delta.p, oldResult.N + delta.N, oldResult.n + delta.n);
+        double quality = rqmPrune.EvaluateRuleQualityFromResult(result);
+        if (fabs(quality - rqmPrune.EvaluateRuleQualityFromResult(oldResult)) > repruneThreshold)
+        {
+            pruneRule(*it, examples, rqmPrune);
+            result = RuleQualityMeasure::EvaluateRule(examples, *it);
+            quality = rqmPrune.EvaluateRuleQualityFromResult(result);
+        }
+        it->setConfidenceDegree(quality);
+        it->setEvaluationResult(result);
+    }
+
+    list<Rule> ruleSet;
+    vector<double> classes = examples.getDistinctClasses();
+    for (vector<double>::iterator itClass = classes.begin(); itClass != classes.end(); itClass++)
+    {
+        double decClass = *itClass;
+        SetOfExamples uncoveredPositives(newExamples.getExamplesForDecAtt(decClass));
+        for (it = rules.begin(); it != rules.end(); )
+        {
+            if (it->getDecisionClass() != decClass)
+            {
+                it++;
+                continue;
+            }
+            SetOfExamples covered(getCoveredExamples(*it, uncoveredPositives));
+            uncoveredPositives = uncoveredPositives - covered;
+            ruleSet.push_back(std::move(*it));
+            it = rules.erase(it);
+        }
+        if (uncoveredPositives.size() == 0 || policy.isClassSkipped(decClass) || !policy.isCoveringAllowed(decClass))
+            continue;
+        RuleEvaluationResult classResult = RuleQualityMeasure::EvaluateClass(examples, decClass);
+        P = classResult.P;
+        N = classResult.N;
+        bool useSpecifiedOnly = policy.isSpecifiedOnly(decClass);
+        int rulesFromSpecifiedConditions = 0;
+        coverPositives(examples, uncoveredPositives, rqmGrow, rqmPrune, decClass, ruleSet, useSpecifiedOnly, rulesFromSpecifiedConditions);
+    }
+    //rules of classes without examples are kept as they are
+    ruleSet.splice(ruleSet.end(), rules);
+    return ruleSet;
+}
+
+/**
+ * Growth phase of a rule induction
+ * @param rule rule to be built
+ * @param covered set of examples covered by current rule
+ * @param uncoveredPositives set of examples not covered by current set of rules
+ * @param ruleQualityMeasure rule quality measure
+ * @param useSpecifiedOnly true if conditions are searched among the specified ones first
+ */
+template <class KnowledgePolicy>
+void CoveringEngine<KnowledgePolicy>::growRule(Rule& rule, SetOfExamples& covered, SetOfExamples uncoveredPositives, RuleQualityMeasure& ruleQualityMeasure, bool useSpecifiedOnly)
+{
+    AllocationPhase phase(AllocationCounter::GROW);
+    ElementaryCondition bestCondition;
+    double decClass = rule.getDecisionClass();
+    RuleEvaluationResult rer;
+    double coveredCount = 0, prevCoveredCount = 0;
+    bool shouldBreak = false, unspecifiedChecked = false, checkUnspecified = true;
+
+    while (uncoveredPositives.size() > 0)
+    {
+        bestCondition = findBestCondition(rule, decClass, covered, uncoveredPositives, ruleQualityMeasure, useSpecifiedOnly);
+
+        unspecifiedChecked = false;
+        checkUnspecified = true;
+        shouldBreak = false;
+        while(!unspecifiedChecked || checkUnspecified)
+        {
+			if(bestCondition.getAttributeIndex() == -1)
+				shouldBreak = true;
+
+			//checking stop criterion
+			if(!shouldBreak)
+			{
+				rer = RuleQualityMeasure::EvaluateCondition(covered, bestCondition, decClass);
+				if (rer.n == 0)
+				{
+					rule.addCondition(bestCondition);
+					//rule.addConditionAndOptimize(bestCondition);
+					shouldBreak = true;
+					checkUnspecified = false;
+					unspecifiedChecked = true;
+				}
+				coveredCount = rer.p + rer.n;
+				if(coveredCount == prevCoveredCount)
+					shouldBreak = true;
+			}
+
+			//if it wasn't possible to find best condition from specified, then if conditions are "expandable"
+			//and "useSpecifiedOnly" (global, not this method parameter) is not true, try to use other conditions
+			if(!unspecifiedChecked && shouldBreak && useSpecifiedOnly && policy.isExpandable(decClass) && !policy.isUseSpecifiedOnly())
+			{
+	        	bestCondition = findBestCondition(rule, decClass, covered, uncoveredPositives, ruleQualityMeasure, false);
+	        	shouldBreak = false;
+			}
+			else
+				checkUnspecified = false;
+
+			unspecifiedChecked = true;
+        }
+
+        if(shouldBreak)
+        	break;
+
+        covered = getCoveredExamples(bestCondition, covered);
+        uncoveredPositives = getCoveredExamples(bestCondition, uncoveredPositives);
+        prevCoveredCount = coveredCount;
+        rule.addCondition(bestCondition);
+        //rule.addConditionAndOptimize(bestCondition);
+        //cout << "Added condition: " << bestCondition.toString(covered.getDataSet()) << endl;
+    }
+}
+
+/**
+ * Finds the best elementary condition from all possible ones
+ * @param rule rule being grown
+ * @param decClass number of positive class
+ * @param covered set of examples covered by current rule
+ * @param uncoveredPositives set of examples not covered by current set of rules but covered by the current rule
+ * @param rqm rule quality measure
+ * @param useSpecifiedOnly true if only the specified conditions are searched
+ * @return the best elementary condition
+ */
+template <class KnowledgePolicy>
+template <class Measure>
+ElementaryCondition CoveringEngine<KnowledgePolicy>::findBestCondition
+(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives, Measure& rqm, bool useSpecifiedOnly)
+{
+    ElementaryCondition bestCondition;
+    ConditionList equallyBestConditions(pool);
+    double bestQuality = -numeric_limits<double>::max();
+
+    int size = covered.size();
+
+    if (size == 0)
+        return bestCondition;
+    int numberOfAtts = covered[0].getNumberOfAttributes();
+
+    //with optimistic bounds the most promising attributes are searched first and the search stops
+    //at the first attribute which cannot give a condition as good as the best one found
+    const bool useBounds = rqm.HasOptimisticBound();
+    attributeOrder.clear();
+    //sparse columns are scanned through their stored values of the covered examples
+    if (covered.getDataSet().getColumns().getNumberOfSparseColumns() > 0)
+        coveredRows.setExamples(covered, decClass);
+    if (useBounds)
+        bound.setExamples(covered, decClass);
+    for (int i = 0; i < numberOfAtts; i++)
+    {
+        double attributeBound = useBounds ? bound.evaluate(rqm, covered, i, P, N, coveredRows) : 0;
+        attributeOrder.push_back(make_pair(attributeBound == attributeBound ? attributeBound : numeric_limits<double>::infinity(), i));
+    }
+    if (useBounds)
+        stable_sort(attributeOrder.begin(), attributeOrder.end(),
+                [](const pair<double, int>& a, const pair<double, int>& b) { return a.first > b.first; });
+
+    for (vector<pair<double, int> >::iterator att = attributeOrder.begin(); att != attributeOrder.end(); att++)
+    {
+        if (useBounds && OptimisticBound::isBelow(att->first, bestQuality))
+            break;
+        int i = att->second;
+        Attribute::AttributeType attributeType = covered.getAttributeType(i);
+        switch (attributeType)
+        {
+			case Attribute::NUMERICAL:
+				findBestConditionForNumericalAttribute(rule, decClass, covered, uncoveredPositives, rqm, i, equallyBestConditions, bestQuality, useSpecifiedOnly);
+				break;
+			case Attribute::NOMINAL:
+				findBestConditionForNominalAttribute(rule, decClass, covered, uncoveredPositives, rqm, i, equallyBestConditions, bestQuality, useSpecifiedOnly);
+				break;
+        }
+    }
+
+    //the condition is drawn from the equally best ones by its position, so they are put back in the order of attributes
+    if (useBounds)
+        equallyBestConditions.sort([](const ElementaryCondition& a, const ElementaryCondition& b)
+                { return a.getAttributeIndex() < b.getAttributeIndex(); });
+
+    //when more than one condition is the best
+    if (equallyBestConditions.size() == 1)
+        bestCondition = equallyBestConditions.front();
+    else if (equallyBestConditions.size() > 1)
+        bestCondition = chooseConditionFromEqual(equallyBestConditions, decClass, uncoveredPositives);
+
+    return bestCondition;
+}
+
+template <class KnowledgePolicy>
+template <class Measure>
+void CoveringEngine<KnowledgePolicy>::findBestConditionForNumericalAttribute
+(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives,
+		Measure& rqm, int attributeIndex, ConditionList& equallyBestConditions, double& bestQuality, bool useSpecifiedOnly)
+{
+	const bool isRqmEntropy = is_same<Measure, NegConditionalEntropy>::value;
+	double mean, quality, ltQuality, currWeight;
+	ElementaryCondition bestCondition;
+	bool shouldSkip = false;
+	int entrLT_p = 0, entrGE_p = 0, size = covered.size();
+	RuleEvaluationResult rer_ge(P, 0, N, 0);
+	RuleEvaluationResult rer_lt(P, 0, N, 0);
+	//<value of an attribute, number of example>
+	//plus: <value of an attribute from specified conditions, index of the condition>
+	PooledMultimap values(less<double>(), pool);
+	double prevVal = numeric_limits<double>::max(), prevClass = -1, currClass;
+
+	const ColumnStore& columns = covered.getDataSet().getColumns();
+	switch (columns.getType(attributeIndex))
+	{
+		case ColumnStore::DOUBLE_COLUMN:
+			addValues(columns.getColumn<double>(attributeIndex), decClass, covered, values, rer_ge);
+			break;
+		case ColumnStore::FLOAT_COLUMN:
+			addValues(columns.getColumn<float>(attributeIndex), decClass, covered, values, rer_ge);
+			break;
+		case ColumnStore::INT_COLUMN:
+			addValues(columns.getColumn<int>(attributeIndex), decClass, covered, values, rer_ge);
+			break;
+		case ColumnStore::SHORT_COLUMN:
+			addValues(columns.getColumn<unsigned short>(attributeIndex), decClass, covered, values, rer_ge);
+			break;
+		case ColumnStore::BYTE_COLUMN:
+			addValues(columns.getColumn<unsigned char>(attributeIndex), decClass, covered, values, rer_ge);
+			break;
+		case ColumnStore::SPARSE_COLUMN:
+			addSparseValues(columns.getSparseColumn(attributeIndex), decClass, covered, values, rer_ge);
+			break;
+	}
+
+	int sizeUnc = uncoveredPositives.size();
+	PooledMultiset uncPosValues(less<double>(), pool);
+
+	for(int j = 0; j < sizeUnc; j++)
+			uncPosValues.insert(columns.getValue(attributeIndex, uncoveredPositives.getIndex(j)));
+
+	double min = *(uncPosValues.begin());
+	double max = *(uncPosValues.rbegin());
+
+	//cout << "Size " << values.size() << "\tMin: " << min << "\tMax: " << max << endl;
+
+	//specified conditions for this attribute:
+	policy.addThresholds(decClass, attributeIndex, values);
+
+	typename PooledMultimap::iterator val = values.begin();
+	prevVal = val->first;
+	const bool unitWeights = covered.hasUnitWeights();
+	bool isGreaterEqualAllowed = true;
+	bool isLessThanAllowed = true;
+	bool additionalValue = false;
+	candidates.clear();
+
+	for(;val != values.end();
+		currClass == decClass ?	(rer_lt.p += currWeight, rer_ge.p -= currWeight)
+							  : (rer_lt.n += currWeight, rer_ge.n -= currWeight), val++)
+	{
+		additionalValue = KnowledgePolicy::hasKnowledge && val->second < 0;	//the value was added from specified conditions
+
+		if(!additionalValue)
+		{
+			if (val->second < size)
+			{
+				currClass = covered[val->second].getDecisionAttribute();
+				currWeight = unitWeights ? 1 : covered.getWeight(val->second);
+			}
+			else	//group of the examples with the default value of a sparse attribute
+			{
+				currClass = defaultGroups[val->second - size].first;
+				currWeight = defaultGroups[val->second - size].second;
+			}
+
+			shouldSkip = currClass == prevClass || prevVal == val->first;
+
+			mean = (prevVal + val->first) / 2;
+			prevVal = val->first;
+			prevClass = currClass;
+
+			if(shouldSkip)
+				continue;
+		}
+		else
+		{
+			mean = val->first;
+			currWeight = 0;
+			currClass = decClass;
+		}
+
+		isGreaterEqualAllowed = policy.isNumericConditionAllowed(rule, decClass, attributeIndex, mean, true, useSpecifiedOnly);
+		isLessThanAllowed = policy.isNumericConditionAllowed(rule, decClass, attributeIndex, mean, false, useSpecifiedOnly);
+
+		if(!isGreaterEqualAllowed && !isLessThanAllowed)
+			continue;
+
+		quality =  -numeric_limits<double>::max();
+		ltQuality = -numeric_limits<double>::max();
+
+		if(!isRqmEntropy)
+			candidates.addCandidate(rqm, mean, rer_ge, mean <= max && isGreaterEqualAllowed, rer_lt, mean > min && isLessThanAllowed);
+		else
+		{
+			entrLT_p = getNumberOfValuesLessOrGreater(uncPosValues, mean, true);
+			entrGE_p = uncPosValues.size() - entrLT_p;
+
+			if(mean <= max && entrGE_p > entrLT_p && isGreaterEqualAllowed)
+				quality = NegConditionalEntropy::ComputeQualityForTwoGroups(rer_lt.p, rer_lt.n, rer_ge.p, rer_ge.n);
+			else if(mean > min /*&& entrGE_p <= entrLT_p*/ && isLessThanAllowed)
+				ltQuality = NegConditionalEntropy::ComputeQualityForTwoGroups(rer_lt.p, rer_lt.n, rer_ge.p, rer_ge.n);
+			else
+				continue;
+			candidates.add(mean, quality, ltQuality);
+		}
+	}
+
+	candidates.evaluate(rqm);
+	vector<ConditionCandidates::Candidate>& cands = candidates.getCandidates();
+	for(vector<ConditionCandidates::Candidate>::iterator cand = cands.begin(); cand != cands.end(); cand++)
+	{
+		mean = cand->value;
+		quality = cand->quality;
+		ltQuality = cand->ltQuality;
+
+		if (quality < bestQuality && ltQuality < bestQuality) continue;
+
+		if(quality > bestQuality || ltQuality > bestQuality)
+		{
+			bestQuality = quality > ltQuality ? quality : ltQuality;
+			equallyBestConditions.clear();
+		}
+
+		if(quality >= ltQuality && quality > -std::numeric_limits<double>::max())
+			equallyBestConditions.push_back(ElementaryCondition(attributeIndex, new GreaterEqualOperator(), mean));
+
+		if(quality <= ltQuality && ltQuality > -std::numeric_limits<double>::max())
+			equallyBestConditions.push_back(ElementaryCondition(attributeIndex, new LessThanOperator(), mean));
+
+		//cout << "Value: " << mean << "\tltQuality: " << ltQuality << "\tgtQuality: " << quality << endl;
+	}
+}
+
+/**
+ * Adds the known values of a numerical attribute of the covered examples to the values searched for thresholds
+ * @param column values of the attribute of the type of the column
+ * @param decClass number of positive class
+ * @param covered set of examples covered by current rule
+ * @param values values of the attribute with positions of the examples (output)
+ * @param rer_ge weights of the examples with known values (output)
+ */
+template <class KnowledgePolicy>
+template <class T>
+void CoveringEngine<KnowledgePolicy>::addValues
+(const T* column, double decClass, SetOfExamples& covered, PooledMultimap& values, RuleEvaluationResult& rer_ge)
+{
+	if (covered.hasUnitWeights())
+		addValues(column, UnitWeights(covered), decClass, covered, values, rer_ge);
+	else
+		addValues(column, ExampleWeights(covered), decClass, covered, values, rer_ge);
+}
+
+template <class KnowledgePolicy>
+template <class T, class Weights>
+void CoveringEngine<KnowledgePolicy>::addValues
+(const T* column, const Weights& weight, double decClass, SetOfExamples& covered, PooledMultimap& values, RuleEvaluationResult& rer_ge)
+{
+	typename Weights::Count p = 0, n = 0;
+	int size = covered.size();
+	//the column is read in the order of the data set (sequentially, when it is memory-mapped)
+	for (int j = 0; j < size; j++)
+	{
+		double attValue = ColumnStore::toDouble(column[covered.getIndex(j)]);
+		if (attValue != attValue) //false if NaN
+			continue;
+
+		values.insert(pair<double, int>(attValue, j));
+
+		if(covered[j].getDecisionAttribute() == decClass)
+			p += weight(j);
+		else
+			n += weight(j);
+	}
+	rer_ge.p += p;
+	rer_ge.n += n;
+}
+
+/**
+ * Adds the values of a sparse numerical attribute of the covered examples to the values searched for
+ * thresholds: the stored values with the positions of their examples and the default value as three
+ * groups with positions size, size + 1 and size + 2 (see defaultGroups). In the sweep over the values
+ * the groups stand for the run of the examples with the default value: the first one has the class of
+ * the first of these examples and the weight of the examples of the same kind (positive or negative),
+ * the second one the weight of the examples of the other kind and the last one the class of the last
+ * of these examples, so the thresholds and their results are the same as for the dense column.
+ * @param column values of the attribute
+ * @param decClass number of positive class
+ * @param covered set of examples covered by current rule (indexed in coveredRows)
+ * @param values values of the attribute with positions of the examples (output)
+ * @param rer_ge weights of the examples with known values (output)
+ */
+template <class KnowledgePolicy>
+void CoveringEngine<KnowledgePolicy>::addSparseValues
+(const SparseColumn& column, double decClass, SetOfExamples& covered, PooledMultimap& values, RuleEvaluationResult& rer_ge)
+{
+	const vector<double>& stored = column.getValues();
+	double defaultValue = column.getDefaultValue();
+	double storedPositive = 0, storedNegative = 0;
+	int size = covered.size();
+	const bool unitWeights = covered.hasUnitWeights();
+
+	coveredRows.findStoredValues(column, storedValues);
+	for (vector<pair<int, int> >::const_iterator it = storedValues.begin(); it != storedValues.end(); it++)
+	{
+		int j = it->first;
+		bool positive = covered[j].getDecisionAttribute() == decClass;
+		double weight = unitWeights ? 1 : covered.getWeight(j);
+		positive ? storedPositive += weight : storedNegative += weight;
+
+		double attValue = stored[it->second];
+		if (attValue != attValue)
+			continue;
+		values.insert(pair<double, int>(attValue, j));
+		positive ? rer_ge.p += weight : rer_ge.n += weight;
+	}
+	if (defaultValue != defaultValue || (int)storedValues.size() == size)
+		return;
+
+	//first and last covered examples with the default value
+	int first = 0, last = size - 1;
+	for (vector<pair<int, int> >::const_iterator it = storedValues.begin(); it != storedValues.end() && it->first == first; it++)
+		first++;
+	for (vector<pair<int, int> >::const_reverse_iterator it = storedValues.rbegin(); it != storedValues.rend() && it->first == last; it++)
+		last--;
+	double firstClass = covered[first].getDecisionAttribute();
+	bool firstPositive = firstClass == decClass;
+	double positiveWeight = max(coveredRows.getPositiveWeight() - storedPositive, 0.0);
+	double negativeWeight = max(coveredRows.getNegativeWeight() - storedNegative, 0.0);
+
+	defaultGroups.clear();
+	defaultGroups.push_back(make_pair(firstClass, firstPositive ? positiveWeight : negativeWeight));
+	//any class of the other kind will do, the group is never a threshold
+	defaultGroups.push_back(make_pair(firstPositive ? decClass + 1 : decClass, firstPositive ? negativeWeight : positiveWeight));
+	defaultGroups.push_back(make_pair(covered[last].getDecisionAttribute(), 0.0));
+	for (int g = 0; g < 3; g++)
+		values.insert(pair<double, int>(defaultValue, size + g));
+	rer_ge.p += positiveWeight;
+	rer_ge.n += negativeWeight;
+}
+
+/**
+ * Sums the weights of the covered examples by the known values of a nominal attribute
+ * @param column values of the attribute of the type of the column
+ * @param decClass number of positive class
+ * @param covered set of examples covered by current rule
+ * @param values results of the values (output)
+ */
+template <class KnowledgePolicy>
+template <class T>
+void CoveringEngine<KnowledgePolicy>::addLevels(const T* column, double decClass, SetOfExamples& covered, PooledResultMap& values)
+{
+	if (covered.hasUnitWeights())
+		addLevels(column, UnitWeights(covered), decClass, covered, values);
+	else
+		addLevels(column, ExampleWeights(covered), decClass, covered, values);
+}
+
+template <class KnowledgePolicy>
+template <class T, class Weights>
+void CoveringEngine<KnowledgePolicy>::addLevels(const T* column, const Weights& weight, double decClass, SetOfExamples& covered, PooledResultMap& values)
+{
+	int size = covered.size();
+	for (int j = 0; j < size; j++)
+	{
+		double attValue = ColumnStore::toDouble(column[covered.getIndex(j)]);
+		if (attValue != attValue) continue; //true if NaN
+
+		if(covered[j].getDecisionAttribute() == decClass)
+			values[attValue].p += weight(j);
+		else
+			values[attValue].n += weight(j);
+	}
+}
+
+template <class KnowledgePolicy>
+template <class Measure>
+void CoveringEngine<KnowledgePolicy>::findBestConditionForNominalAttribute
+(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives,
+		Measure& rqm, int attributeIndex, ConditionList& equallyBestConditions, double& bestQuality, bool useSpecifiedOnly)
+{
+	const bool isRqmEntropy = is_same<Measure, NegConditionalEntropy>::value;
+	PooledResultMap values(less<double>(), pool);
+	double p = 0, n = 0, quality;
+
+	const ColumnStore& columns = covered.getDataSet().getColumns();
+	switch (columns.getType(attributeIndex))
+	{
+		case ColumnStore::BYTE_COLUMN:
+			addLevels(columns.getColumn<unsigned char>(attributeIndex), decClass, covered, values);
+			break;
+		case ColumnStore::SHORT_COLUMN:
+			addLevels(columns.getColumn<unsigned short>(attributeIndex), decClass, covered, values);
+			break;
+		case ColumnStore::INT_COLUMN:
+			addLevels(columns.getColumn<int>(attributeIndex), decClass, covered, values);
+			break;
+		default:
+			addLevels(columns.getColumn<double>(attributeIndex), decClass, covered, values);
+	}
+
+	for(auto val = values.begin(); val != values.end(); val++)
+	{
+		p += val->second.p;
+		n += val->second.n;
+	}
+
+	candidates.clear();
+	if(useSpecifiedOnly)
+	{
+		const vector<KnowledgeCondition>& kConditions = policy.getAllowedConditions(decClass, attributeIndex);
+		for(vector<KnowledgeCondition>::const_iterator kCond = kConditions.begin(); kCond != kConditions.end(); kCond++)
+		{
+			if(!policy.isNominalConditionAllowed(rule, decClass, attributeIndex, kCond->getValue()) ||
+				!existsExampleWithEqualAttValue(attributeIndex, kCond->getValue(), uncoveredPositives))
+						continue;
+
+			RuleEvaluationResult rer = values[kCond->getValue()];
+
+			if(!isRqmEntropy)
+			{
+				rer.P = P; rer.N = N;
+				candidates.addCandidate(rqm, kCond->getValue(), rer, true, rer, false);
+			}
+			else
+			{
+				quality = NegConditionalEntropy::ComputeQualityForTwoGroups(rer.p, rer.n,
+																			p - rer.p, n - rer.n);
+				candidates.add(kCond->getValue(), quality, 0);
+			}
+		}
+	}
+	else
+	{
+		for(auto val = values.begin(); val != values.end(); val++)
+		{
+			if(!policy.isNominalConditionAllowed(rule, decClass, attributeIndex, val->first) ||
+					!existsExampleWithEqualAttValue(attributeIndex, val->first, uncoveredPositives))
+				continue;
+
+			if(!isRqmEntropy)
+			{
+				val->second.P = P; val->second.N = N;
+				candidates.addCandidate(rqm, val->first, val->second, true, val->second, false);
+			}
+			else
+			{
+				quality = NegConditionalEntropy::ComputeQualityForTwoGroups(val->second.p, val->second.n,
+																			p - val->second.p, n - val->second.n);
+				candidates.add(val->first, quality, 0);
+			}
+		}
+	}
+
+	candidates.evaluate(rqm);
+	vector<ConditionCandidates::Candidate>& cands = candidates.getCandidates();
+	for(vector<ConditionCandidates::Candidate>::iterator cand = cands.begin(); cand != cands.end(); cand++)
+	{
+		quality = cand->quality;
+
+		if (quality < bestQuality || quality == -std::numeric_limits<double>::max() || quality != quality) continue;
+
+		if(quality > bestQuality)
+		{
+			bestQuality = quality;
+			equallyBestConditions.clear();
+		}
+
+		equallyBestConditions.push_back(ElementaryCondition(attributeIndex, new EqualityOperator(), cand->value));
+	}
+}
+
+/**
+ * Finds the best elementary condition using the search compiled for the type of the measure.
+ * Measures of other types are evaluated through virtual calls: measures defined in R (CustomMeasure)
+ * or by formulas (ExpressionMeasure) and the built-in measures which cannot be chosen for the induction
+ * (Precision, Coverage, MutualSupport, CohenMeasure, Pvalue). A new measure available for the induction
+ * has to be added to the list below, otherwise it works, but through the slower virtual calls.
+ * @param rule rule being grown
+ * @param decClass number of positive class
+ * @param covered set of examples covered by current rule
+ * @param uncoveredPositives set of examples not covered by current set of rules but covered by the current rule
+ * @param rqm rule quality measure
+ * @param useSpecifiedOnly true if only the specified conditions are searched
+ * @return the best elementary condition
+ */
+template <class KnowledgePolicy>
+ElementaryCondition CoveringEngine<KnowledgePolicy>::findBestCondition
+(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives, RuleQualityMeasure& rqm, bool useSpecifiedOnly)
+{
+	const type_info& type = typeid(rqm);
+	if (type == typeid(TwoMeasure)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<TwoMeasure&>(rqm), useSpecifiedOnly);
+	if (type == typeid(Lift)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<Lift&>(rqm), useSpecifiedOnly);
+	if (type == typeid(LogicalSufficiency)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<LogicalSufficiency&>(rqm), useSpecifiedOnly);
+	if (type == typeid(RSS)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<RSS&>(rqm), useSpecifiedOnly);
+	if (type == typeid(Correlation)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<Correlation&>(rqm), useSpecifiedOnly);
+	if (type == typeid(SBayesConfirmation)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<SBayesConfirmation&>(rqm), useSpecifiedOnly);
+	if (type == typeid(C1)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<C1&>(rqm), useSpecifiedOnly);
+	if (type == typeid(C2)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<C2&>(rqm), useSpecifiedOnly);
+	if (type == typeid(NegConditionalEntropy)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<NegConditionalEntropy&>(rqm), useSpecifiedOnly);
+	if (type == typeid(Cn2)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<Cn2&>(rqm), useSpecifiedOnly);
+	if (type == typeid(Gain)) return findBestCondition(rule, decClass, covered, uncoveredPositives, static_cast<Gain&>(rqm), useSpecifiedOnly);
+	return findBestCondition<RuleQualityMeasure>(rule, decClass, covered, uncoveredPositives, rqm, useSpecifiedOnly);
+}
+
+template <class KnowledgePolicy>
+int CoveringEngine<KnowledgePolicy>::getNumberOfValuesLessOrGreater(PooledMultiset& values, double value, bool takeLess)
+{
+	int cnt = 0;
+	for(auto it = values.begin(); it != values.end() && *it < value; it++, cnt++);
+
+	return takeLess ? cnt : values.size() - cnt;
+}
+
+/**
+ * Chooses one elementary condition from conditions with the same value of rule quality measure
+ * @param equallyBestConditions list of the equally best conditions
+ * @param decClass positive class value
+ * @param uncoveredPositives set of examples not covered by current set of rules but covered by the current rule
+ * @return chosen condition
+ */
+template <class KnowledgePolicy>
+ElementaryCondition CoveringEngine<KnowledgePolicy>::chooseConditionFromEqual(ConditionList& equallyBestConditions, double decClass, SetOfExamples& uncoveredPositives)
+{
+    vector<ElementaryCondition> equallyCoveringConds;
+    typename ConditionList::iterator bestCondIt;
+    double pMax = 0;
+    RuleEvaluationResult rer;
+    for (bestCondIt = equallyBestConditions.begin(); bestCondIt != equallyBestConditions.end(); bestCondIt++)
+    {
+        rer = RuleQualityMeasure::EvaluateCondition(uncoveredPositives, *bestCondIt, decClass);
+        if (rer.p > pMax)
+        {
+            equallyCoveringConds.clear();
+            equallyCoveringConds.push_back(*bestCondIt);
+            pMax = rer.p;
+        }
+        else if (rer.p == pMax)
+            equallyCoveringConds.push_back(*bestCondIt);
+    }
+    return equallyCoveringConds[context.getRandom().nextInt(equallyCoveringConds.size())]; //works also for one condition
+}
+
+/**
+ * Pruning the rule; conditions required by the knowledge are not removed
+ * @param rule rule to be pruned
+ * @param examples training set
+ * @param ruleQualityMeasure rule quality measure
+ */
+template <class KnowledgePolicy>
+void CoveringEngine<KnowledgePolicy>::pruneRule(Rule& rule, SetOfExamples& examples, RuleQualityMeasure& ruleQualityMeasure)
+{
+    AllocationPhase phase(AllocationCounter::PRUNE);
+    list<ElementaryCondition>::iterator itList;
+    double bestQuality = ruleQualityMeasure.EvaluateRuleQuality(examples, rule);
+    double currentQuality;
+    vector<ElementaryCondition> equallyWorstConds;
+    Rule tempRule;
+    ElementaryCondition* conditionToRemove;
+    unsigned int numberOfAtts = rule.getConditions().size();
+    while (1)
+    {
+        equallyWorstConds.clear();
+        tempRule = rule;
+        for (unsigned int i = 0; i < numberOfAtts; i++)
+            for (itList = rule.getConditions()[i].begin(); itList != rule.getConditions()[i].end(); itList++)
+            {
+                if (policy.isConditionRequired(*itList, rule, examples.getAttributeType(i)))	//can't remove condition if it is required
+                    continue;
+
+                tempRule.removeCondition(*itList);
+                currentQuality = ruleQualityMeasure.EvaluateRuleQuality(examples, tempRule);
+                if (currentQuality > bestQuality)
+                {
+                    bestQuality = currentQuality;
+                    equallyWorstConds.clear();
+                    equallyWorstConds.push_back(*itList);
+                }
+                else if((currentQuality == bestQuality) || (currentQuality != currentQuality && bestQuality != bestQuality))	//equal or both are NaN
+                    equallyWorstConds.push_back(*itList);
+                tempRule.addCondition(*itList);
+            }
+        if (equallyWorstConds.empty())
+            break;
+
+        conditionToRemove = &equallyWorstConds[context.getRandom().nextInt(equallyWorstConds.size())];
+        rule.removeCondition(*conditionToRemove);
+        //cout << "Removed condition: " << conditionToRemove->toString(examples.getDataSet()) << "\tBestQuality: " << bestQuality << endl;
+    }
+}
+
+/**
+ * Returns set of examples covered by the rule
+ * @param rule decision rule
+ * @param examples set of examples
+ * @return set of examples covered by the rule
+ */
+template <class KnowledgePolicy>
+SetOfExamples CoveringEngine<KnowledgePolicy>::getCoveredExamples(Rule& rule, SetOfExamples& examples)
+{
+    SetOfExamples covered(examples.getDataSet());
+    for (int i = 0; i < examples.size(); i++)
+    {
+        if (rule.covers(examples[i]))
+            covered.addExample(examples, i);
+    }
+    return covered;
+}
+
+/**
+ * Returns set of examples covered by the condition
+ * @param cond condition
+ * @param examples set of examples
+ * @return set of examples covered by the condition
+ */
+template <class KnowledgePolicy>
+SetOfExamples CoveringEngine<KnowledgePolicy>::getCoveredExamples(ElementaryCondition& cond, SetOfExamples& examples)
+{
+    SetOfExamples covered(examples.getDataSet());
+    int attIndex = cond.getAttributeIndex();
+    for (int i = 0; i < examples.size(); i++)
+    {
+        if (cond.isSatisfied(examples[i].getAttribute(attIndex)))
+            covered.addExample(examples, i);
+    }
+    return covered;
+}
+
+/**
+ * Checks if the set contains at least one instance covered by the rule.
+ * @param rule decision rule
+ * @param examples set of examples
+ * @return true or false
+ */
+template <class KnowledgePolicy>
+bool CoveringEngine<KnowledgePolicy>::existsCoveredExample(Rule& rule, SetOfExamples& examples)
+{
+    for (int i = 0; i < examples.size(); i++)
+    {
+        if (rule.covers(examples[i]))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Checks if the set contains at least one instance covered by the elementary condition
+ * @param condition elementary condition
+ * @param examples set of examples
+ * @return true or false
+ */
+template <class KnowledgePolicy>
+bool CoveringEngine<KnowledgePolicy>::existsCoveredExample(ElementaryCondition& condition,SetOfExamples& examples)
+{
+    int attIndex = condition.getAttributeIndex();
+    for (int i = 0; i < examples.size(); i++)
+    {
+        if(condition.isSatisfied(examples[i].getAttribute(attIndex)))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Check if the set of examples contains at least one example with certain value of the attribute
+ * @param attIndex attribute index
+ * @param attValue attribute value
+ * @param examples set of examples
+ * @return true or false
+ */
+template <class KnowledgePolicy>
+bool CoveringEngine<KnowledgePolicy>::existsExampleWithEqualAttValue(int attIndex, double attValue, SetOfExamples& examples)
+{
+    int size = examples.size();
+    for (int i = 0; i < size; i++)
+        if(attValue == examples[i].getAttribute(attIndex))
+            return true;
+    return false;
+}
+
+/**
+ * Creates a rule from the conditions of a rule of the knowledge
+ * @param kRule rule of the knowledge
+ * @param fixedAndRequiredOnly true if only the fixed and required conditions are taken
+ * @return rule
+ */
+template <class KnowledgePolicy>
+Rule CoveringEngine<KnowledgePolicy>::getRuleFromKnowledgeRule(KnowledgeRule& kRule, bool fixedAndRequiredOnly)
+{
+	Rule rule;
+	SetOfConditions& kConds = kRule.getConditions();
+
+	rule.setDecisionClass(kConds.getDecisionClass());
+
+	for(list<KnowledgeCondition>::iterator it = kConds.getConditions().begin(); it != kConds.getConditions().end(); it++)
+	{
+		if(fixedAndRequiredOnly && !(it->isFixed() && it->isRequired()))
+			continue;
+
+		if(it->getAttributeType() == Attribute::NOMINAL)
+		{
+			if(it->getValue() == it->getValue())
+			{
+				ElementaryCondition newCondition(it->getAttributeIndex(), new EqualityOperator(), it->getValue());
+				rule.addCondition(newCondition);
+			}
+		}
+		else
+		{
+			if(it->getFrom() > -numeric_limits<double>::max())
+			{
+				ElementaryCondition newCondition(it->getAttributeIndex(), new GreaterEqualOperator(), it->getFrom());
+				rule.addCondition(newCondition);
+			}
+
+			if(it->getTo() < numeric_limits<double>::max())
+			{
+				ElementaryCondition newCondition(it->getAttributeIndex(), new LessThanOperator(), it->getTo());
+				rule.addCondition(newCondition);
+			}
+		}
+	}
+	return rule;
+}
+
+//the engine is compiled for the policies used by SequentialCovering and SequentialCoveringWithPreferences
+template class CoveringEngine<NoKnowledgePolicy>;
+template class CoveringEngine<PreferencesPolicy>;
@@ -0,0 +1,109 @@
+#ifndef COVERINGENGINE_H
+#define	COVERINGENGINE_H
+
+#include "Attribute.h"
+#include "Example.h"
+#include "ElementaryCondition.h"
+#include "SetOfExamples.h"
+#include "Rule.h"
+#include "RuleQualityMeasure.h"
+#include "Operator.h"
+#include "MemoryPool.h"
+#include "ConditionCandidates.h"
+#include "OptimisticBound.h"
+#include "CoveredRows.h"
+#include "ExampleWeights.h"
+#include "UnitWeights.h"
+#include "InductionContext.h"
+#include "KnowledgeRule.h"
+#include <assert.h>
+#include <cstdlib>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <typeinfo>
+#include <type_traits>
+
+/**
+ * Sequential covering strategy for induction of decision rules. Performs the induction of decision rules
+ * based on given training set and using specific rule quality measures for the phases of rule growth and pruning.
+ *
+ * The knowledge guiding the induction is a policy chosen at compile time (NoKnowledgePolicy or PreferencesPolicy).
+ * The engine asks the policy which classes are induced, which conditions are allowed in the search for the best
+ * condition and which ones cannot be pruned; with NoKnowledgePolicy the checks are constants and the search
+ * is compiled as without any knowledge.
+ */
+template <class KnowledgePolicy>
+class CoveringEngine
+{
+public:
+	/** random numbers and settings are taken from the context, which has to outlive the object*/
+	CoveringEngine(InductionContext& context, const KnowledgePolicy& policy = KnowledgePolicy()) : policy(policy), context(context), P(0), N(0) {}
+	std::list<Rule> generateRules(SetOfExamples& examples, RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune);
+	std::list<Rule> generateRules(SetOfExamples& examples, RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune, std::list<Rule>& initialRules);
+	std::list<Rule> generateRulesForClass(SetOfExamples&, RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune, double decClass,
+			std::list<Rule>* initialRules = NULL);
+	std::list<Rule> updateRules(std::list<Rule>& rules, SetOfExamples& examples, SetOfExamples& newExamples,
+			RuleQualityMeasure& rqmGrow, RuleQualityMeasure& rqmPrune, double repruneThreshold) throw (RulesInductionException);
+	void growRule(Rule& rule, SetOfExamples& covered, SetOfExamples uncoveredPositives, RuleQualityMeasure& ruleQualityMeasure, bool useSpecifiedOnly = false);
+	void pruneRule(Rule& rule, SetOfExamples& examples, RuleQualityMeasure& ruleQualityMeasure);
+	SetOfExamples getCoveredExamples(Rule& rule, SetOfExamples& examples);
+    SetOfExamples getCoveredExamples(ElementaryCondition& cond, SetOfExamples& examples);
+protected:
+	KnowledgePolicy policy; /**< knowledge guiding the induction*/
+private:
+	/** containers of temporary objects created during the search for the best condition*/
+	typedef std::list<ElementaryCondition, PoolAllocator<ElementaryCondition> > ConditionList;
+	typedef std::multiset<double, std::less<double>, PoolAllocator<double> > PooledMultiset;
+	typedef std::multimap<double, int, std::less<double>, PoolAllocator<std::pair<const double, int> > > PooledMultimap;
+	typedef std::map<double, RuleEvaluationResult, std::less<double>, PoolAllocator<std::pair<const double, RuleEvaluationResult> > > PooledResultMap;
+
+	bool existsCoveredExample(Rule& rule,SetOfExamples& examples);
+	bool existsCoveredExample(ElementaryCondition& condition,SetOfExamples& examples);
+	bool existsExampleWithEqualAttValue(int attIndex, double attValue, SetOfExamples& examples);
+	void expandAllowedRules(SetOfExamples& examples, SetOfExamples& uncoveredPositives, RuleQualityMeasure& rqmGrow,
+			RuleQualityMeasure& rqmPrune, double decClass, std::list<Rule>& ruleSet, bool& useSpecifiedOnly, int& rulesFromSpecifiedConditions);
+	void seedRules(std::list<Rule>& initialRules, SetOfExamples& examples, SetOfExamples& uncoveredPositives,
+			RuleQualityMeasure& rqmPrune, double decClass, std::list<Rule>& ruleSet);
+	void coverPositives(SetOfExamples& examples, SetOfExamples& uncoveredPositives, RuleQualityMeasure& rqmGrow,
+			RuleQualityMeasure& rqmPrune, double decClass, std::list<Rule>& ruleSet, bool& useSpecifiedOnly, int& rulesFromSpecifiedConditions);
+	ElementaryCondition findBestCondition(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives, RuleQualityMeasure& rqm, bool useSpecifiedOnly);
+	/** the search is compiled for every built-in measure, so the formula of the measure is inlined into the scans*/
+	template <class Measure>
+	ElementaryCondition findBestCondition(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives, Measure& rqm, bool useSpecifiedOnly);
+	template <class Measure>
+	void findBestConditionForNominalAttribute(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives,
+			Measure& rqm, int attributeIndex, ConditionList& equallyBestConditions, double& bestQuality, bool useSpecifiedOnly);
+	template <class Measure>
+	void findBestConditionForNumericalAttribute(Rule& rule, double decClass, SetOfExamples& covered, SetOfExamples& uncoveredPositives,
+			Measure& rqm, int attributeIndex, ConditionList& equallyBestConditions, double& bestQuality, bool useSpecifiedOnly);
+	template <class T>
+	void addValues(const T* column, double decClass, SetOfExamples& covered, PooledMultimap& values, RuleEvaluationResult& rer_ge);
+	template <class T, class Weights>
+	void addValues(const T* column, const Weights& weight, double decClass, SetOfExamples& covered, PooledMultimap& values, RuleEvaluationResult& rer_ge);
+	template <class T>
+	void addLevels(const T* column, double decClass, SetOfExamples& covered, PooledResultMap& values);
+	template <class T, class Weights>
+	void addLevels(const T* column, const Weights& weight, double decClass, SetOfExamples& covered, PooledResultMap& values);
+	void addSparseValues(const SparseColumn& column, double decClass, SetOfExamples& covered, PooledMultimap& values, RuleEvaluationResult& rer_ge);
+	ElementaryCondition chooseConditionFromEqual(ConditionList& equallyBestConditions, double decClass, SetOfExamples& uncoveredPositives);
+	int getNumberOfValuesLessOrGreater(PooledMultiset& values, double value, bool takeLess);
+	static Rule getRuleFromKnowledgeRule(KnowledgeRule& kRule, bool fixedAndRequiredOnly = false);
+
+	InductionContext& context; /**< random number generator and settings of the induction*/
+	double P; /**< Number of all positive examples*/
+    double N; /**< Number of all negative examples*/
+	MemoryPool pool; /**< memory for temporary objects; reset before the induction of every rule*/
+	ConditionCandidates candidates; /**< candidate conditions of the currently scanned attribute*/
+	OptimisticBound bound; /**< summary of the currently bounded attribute*/
+	CoveredRows coveredRows; /**< covered examples by their rows, for the scans of sparse columns*/
+	std::vector<std::pair<int, int> > storedValues; /**< covered examples among the stored values of the scanned sparse column*/
+	std::vector<std::pair<double, double> > defaultGroups; /**< classes and weights of the groups of examples with the default value of the scanned sparse column*/
+	std::vector<std::pair<double, int> > attributeOrder; /**< optimistic bounds and indices of attributes in the order of the search*/
+};
+
+#endif	/* COVERINGENGINE_H */
@@ -1,17 +1,37 @@
 #include "DataSet.h"
 using namespace std;
 
-DataSet::DataSet() : decisionAttributeIndex(-1)
+DataSet::DataSet() : columns(new ColumnStore()), decisionAttributeIndex(-1), unitWeights(true)
 {
 }
 
-DataSet::DataSet(const DataSet& orig)
+DataSet::DataSet(const DataSet& orig) throw (RulesInductionException)
+    : examples(orig.examples), columns(new ColumnStore()), attributes(orig.attributes),
+      decisionAttributeIndex(orig.decisionAttributeIndex), unitWeights(orig.unitWeights), name(orig.name)
 {
-    copy(orig.examples.begin(), orig.examples.end(), back_inserter(examples));
+    columns->setMemoryBudget(orig.columns->getMemoryBudget());
+    columns->setSpillDirectory(orig.columns->getSpillDirectory());
+    columns->setMaxSparseDensity(orig.columns->getMaxSparseDensity());
+    columns->setSinglePrecision(orig.columns->isSinglePrecision());
+    columns->copyColumns(*orig.columns);
+    for (size_t i = 0; i < examples.size(); i++)
+        examples[i].setColumns(columns, i);
 }
 
 DataSet::~DataSet()
 {
+    delete columns;
+}
+
+/**
+ * Creates examples referring to the rows of the columns
+ * @param size number of examples
+ */
+void DataSet::createExamples(size_t size)
+{
+    examples.reserve(size);
+    for (size_t i = 0; i < size; i++)
+        examples.push_back(Example(columns, i));
 }
 
 void DataSet::addAttribute(vector<double> values, Attribute attribute) throw(RulesInductionException)
@@ -19,30 +39,16 @@ void DataSet::addAttribute(vector<double> values, Attribute attribute) throw(Rul
     int index = attributes.size();
     vector<Example>::iterator it;
     vector<double>::iterator itVal;
-    if (!examples.empty())
-    {
-        if (examples.size() != values.size())
-            throw RulesInductionException("Inconsistent input data");
-
-        if (index == decisionAttributeIndex)
-            for (it = examples.begin(), itVal = values.begin(); it != examples.end(); it++, itVal++)
-                it->setDecisionAttribute(*itVal);
-        else
-            for (it = examples.begin(), itVal = values.begin(); it != examples.end(); it++, itVal++)
-                it->addAttribute(*itVal);
-    }
+    if (examples.empty())
+        createExamples(values.size());
+    else if (examples.size() != values.size())
+        throw RulesInductionException("Inconsistent input data");
+
+    if (index == decisionAttributeIndex)
+        for (it = examples.begin(), itVal = values.begin(); it != examples.end(); it++, itVal++)
+            it->setDecisionAttribute(*itVal);
     else
-    {
-        for (itVal = values.begin(); itVal != values.end(); itVal++)
-        {
-            Example example;
-            if (index == decisionAttributeIndex)
-                example.setDecisionAttribute(*itVal);
-            else
-                example.addAttribute(*itVal);
-            examples.push_back(example);
-        }
-    }
+        columns->addColumn(values, attribute.getType() == Attribute::NUMERICAL);
     attributes.push_back(attribute);
 }
 
@@ -50,6 +56,7 @@ void DataSet::addWeights(vector<double> weights) throw(RulesInductionException)
 {
     vector<Example>::iterator it;
     vector<double>::iterator itVal;
+    unitWeights = count(weights.begin(), weights.end(), 1.0) == (long)weights.size();
     if (!examples.empty())
     {
         if (examples.size() != weights.size())
@@ -60,11 +67,9 @@ void DataSet::addWeights(vector<double> weights) throw(RulesInductionException)
     }
     else
     {
-        for (itVal = weights.begin(); itVal != weights.end(); itVal++)
-        {
-            examples.push_back(Example());
-            examples.back().setWeight(*itVal);
-        }
+        createExamples(weights.size());
+        for (it = examples.begin(), itVal = weights.begin(); it != examples.end(); it++, itVal++)
+            it->setWeight(*itVal);
     }
 }
 
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <fstream>
 #include "Example.h"
+#include "ColumnStore.h"
 #include "RulesInductionException.h"
 
 
@@ -16,7 +17,7 @@
 class DataSet {
 public:
     DataSet();
-    DataSet(const DataSet& orig);
+    DataSet(const DataSet& orig) throw (RulesInductionException);
     virtual ~DataSet();
 
     std::vector<Example>& getExamples() { return examples; }
@@ -31,14 +32,25 @@ public:
     void setName(std::string name) { this->name = name; }
     std::string getName() const { return name; }
     void addWeights(std::vector<double> weights) throw (RulesInductionException);
+    /** @return true if every example has weight 1*/
+    bool hasUnitWeights() const { return unitWeights; }
     Attribute& getConditionalAttribute(int index) {return attributes[index < decisionAttributeIndex ? index : index + 1]; }
     Attribute& getDecisionAttribute() {return attributes[decisionAttributeIndex]; }
     int getConditionalAttributeIndex(std::string name);
+    ColumnStore& getColumns() { return *columns; }
+    void setMemoryBudget(std::size_t bytes) { columns->setMemoryBudget(bytes); }
+    void setSpillDirectory(const std::string& directory) { columns->setSpillDirectory(directory); }
+    void setMaxSparseDensity(double density) { columns->setMaxSparseDensity(density); }
+    void setSinglePrecision(bool singlePrecision) { columns->setSinglePrecision(singlePrecision); }
 
 private:
+    void createExamples(std::size_t size);
+
     std::vector<Example> examples;
+    ColumnStore* columns;   /**< values of the conditional attributes; allocated separately, because examples refer to it*/
     std::vector<Attribute> attributes;
     int decisionAttributeIndex;
+    bool unitWeights;
     std::string name;
 };
 
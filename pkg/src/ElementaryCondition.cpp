@@ -19,6 +19,14 @@ ElementaryCondition::ElementaryCondition(const ElementaryCondition& orig)
 		_operator = NULL;
 }
 
+ElementaryCondition::ElementaryCondition(ElementaryCondition&& orig) noexcept
+{
+    attributeIndex = orig.attributeIndex;
+    attributeValue = orig.attributeValue;
+    _operator = orig._operator;
+    orig._operator = NULL;
+}
+
 ElementaryCondition::~ElementaryCondition()
 {
 	delete _operator;
@@ -26,7 +34,7 @@ ElementaryCondition::~ElementaryCondition()
 
 ElementaryCondition& ElementaryCondition::operator =(const ElementaryCondition& orig)
 {
-	if(*this == orig)
+	if(this == &orig)
 		return *this;
     delete _operator;
     attributeIndex = orig.attributeIndex;
@@ -38,6 +46,18 @@ ElementaryCondition& ElementaryCondition::operator =(const ElementaryCondition&
 	return *this;
 }
 
+ElementaryCondition& ElementaryCondition::operator =(ElementaryCondition&& orig) noexcept
+{
+	if(this == &orig)
+		return *this;
+	delete _operator;
+	attributeIndex = orig.attributeIndex;
+	attributeValue = orig.attributeValue;
+	_operator = orig._operator;
+	orig._operator = NULL;
+	return *this;
+}
+
 bool ElementaryCondition::operator ==(const ElementaryCondition& toCompare) const
 {
     if (toCompare._operator == NULL || _operator == NULL) return false;
@@ -75,8 +95,11 @@ string ElementaryCondition::toString(DataSet& ds)
 	return str.str();
 }
 
-
-void ElementaryCondition::print()
+/**
+ * Writes the condition to the stream
+ * @param out stream
+ */
+void ElementaryCondition::print(ostream& out)
 {
-	cout << this->toString();
+	out << this->toString();
 }
@@ -18,14 +18,16 @@ public:
     ElementaryCondition(): attributeIndex(-1), _operator(0), attributeValue(0) {};
     ElementaryCondition(int attributeIndex, RelationalOperator* _operator, double attributeValue);
     ElementaryCondition(const ElementaryCondition&);
+    ElementaryCondition(ElementaryCondition&&) noexcept;
     ~ElementaryCondition();
     /**
       * Main method of the class. Checks if the value satisfies the condition.
       * @param value the value that is tested.
       * @return true - if the condition is true, false - otherwise.
      */
-    bool isSatisfied(double value){ return (*_operator)(value, attributeValue); }
+    bool isSatisfied(double value) const { return (*_operator)(value, attributeValue); }
     ElementaryCondition& operator=(const ElementaryCondition&);
+    ElementaryCondition& operator=(ElementaryCondition&&) noexcept;
     bool operator==(const ElementaryCondition&)  const;
     bool operator!=(const ElementaryCondition&)  const;
     void setAttributeIndex(int attributeIndex) { this->attributeIndex = attributeIndex; }
@@ -34,7 +36,7 @@ public:
     RelationalOperator* getOperator() const { return _operator; }
     void setAttributeValue(double attributeValue) { this->attributeValue = attributeValue; }
     double getAttributeValue() const { return attributeValue; }
-    void print();
+    void print(std::ostream& out);
     std::string toString();
     std::string toString(DataSet&);
 private:
@@ -1,12 +1,12 @@
 #include "Example.h"
 using namespace std;
 
-Example::Example() {
+Example::Example() : columns(NULL), row(-1) {
     decisionAttribute = -1;
     weight = 1;
 }
 
-Example::Example(int noOfAttributes) : attributes(noOfAttributes) {
+Example::Example(const ColumnStore* columns, int row) : columns(columns), row(row) {
     decisionAttribute = -1;
     weight = 1;
 }
@@ -21,44 +21,28 @@ Example::~Example() {
 string Example::toString()
 {
 	ostringstream oss;
-	vector<double>::const_iterator it;
-    for(it = attributes.begin(); it != attributes.end(); it++)
-    {
-        oss << *it << '\t';
-    }
-    oss << "|  " << decisionAttribute;
+	oss << *this;
 	return oss.str();
 }
 
 ostream& operator<<(ostream& out, const Example& example)
 {
-    vector<double>::const_iterator it;
-    for(it = example.attributes.begin(); it != example.attributes.end(); it++)
+    for(int i = 0; i < example.getNumberOfAttributes(); i++)
     {
-        out << *it << '\t';
+        out << example.getAttribute(i) << '\t';
     }
     out << "|  " << example.decisionAttribute;
     return out;
 }
 
-void Example::addAttribute(double value) {
-    attributes.push_back(value);
-}
-
-
-double Example::getAttribute(int index) {
-    return attributes[index];
-}
-
-double Example::operator [](int index) {
-    return attributes[index];
-}
-
 bool Example::operator ==(const Example& toCompare) const{
 
-	if(decisionAttribute != toCompare.decisionAttribute)
+	if(decisionAttribute != toCompare.decisionAttribute || getNumberOfAttributes() != toCompare.getNumberOfAttributes())
 		return false;
-    return equal(attributes.begin(), attributes.end(), toCompare.attributes.begin()); 
+    for(int i = 0; i < getNumberOfAttributes(); i++)
+        if(getAttribute(i) != toCompare.getAttribute(i))
+            return false;
+    return true;
 }
 
 
@@ -1,22 +1,25 @@
 #ifndef EXAMPLE_H
 #define	EXAMPLE_H
 #include "Attribute.h"
+#include "ColumnStore.h"
 #include <vector>
 #include <algorithm>
 
 
 /**
- * Represents single example (object) in dataset. Vector of attribute values.
+ * Represents single example (object) in dataset. Values of its conditional attributes are kept
+ * by columns in the ColumnStore of the data set, the example refers to its row there.
  */
 class Example {
 public:
     Example();
-    Example(int);
+    Example(const ColumnStore* columns, int row);
     Example(const Example& orig);
+    Example& operator=(const Example& orig) = default;
     virtual ~Example();
-    void addAttribute(double);
-    double getAttribute(int index);
-    double operator[](int index);
+    double getAttribute(int index) const { return columns->getValue(index, row); }
+    double operator[](int index) const { return getAttribute(index); }
+    int getNumberOfAttributes() const { return columns == NULL ? 0 : columns->getNumberOfColumns(); }
     bool operator==(const Example&) const;
     bool operator!=(const Example& toCompare){return !operator==(toCompare);}
     std::string toString();
@@ -26,13 +29,14 @@ public:
         this->decisionAttribute = decisionAttribute;
     }
     double getDecisionAttribute() const { return decisionAttribute; }
-    void setAttributes(std::vector<double>& attributes) { this->attributes = attributes; }
-    std::vector<double>& getAttributes() { return attributes; }
+    void setColumns(const ColumnStore* columns, int row) { this->columns = columns; this->row = row; }
+    int getRow() const { return row; }
     void setWeight(double weight) { this->weight = weight; }
     double getWeight() const { return weight; }
 
 private:
-    std::vector<double> attributes;
+    const ColumnStore* columns;
+    int row;    /**< index of the example in the data set*/
     double decisionAttribute;
     double weight;
 };
@@ -0,0 +1,21 @@
+#ifndef EXAMPLEWEIGHTS_H
+#define	EXAMPLEWEIGHTS_H
+
+#include "SetOfExamples.h"
+
+/**
+ * Weights of the examples of a set, as read by counting kernels (see UnitWeights).
+ * Count is the type of the sums of the weights.
+ */
+class ExampleWeights
+{
+public:
+    typedef double Count;
+
+    explicit ExampleWeights(SetOfExamples& examples) : examples(examples) {}
+    double operator()(int i) const { return examples.getWeight(i); }
+private:
+    SetOfExamples& examples;
+};
+
+#endif	/* EXAMPLEWEIGHTS_H */
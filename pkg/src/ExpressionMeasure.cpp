@@ -0,0 +1,385 @@
+#include "ExpressionMeasure.h"
+#include <cmath>
+#include <cstdlib>
+#include <cctype>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+/**
+ * Recursive descent parser which emits the bytecode of the expression.
+ * Precedence of operators (from the lowest): || |, && &, !, comparisons, + -, * /, unary -, ^
+ */
+class ExpressionMeasure::Parser
+{
+public:
+    Parser(ExpressionMeasure& measure, const string& text) : measure(measure), text(text), pos(0) {}
+
+    void parse()
+    {
+        parseOr();
+        skipSpaces();
+        if (pos < text.size())
+            error("unexpected symbol");
+    }
+private:
+    void parseOr()
+    {
+        parseAnd();
+        while (acceptOperator("||") || acceptOperator("|"))
+        {
+            parseAnd();
+            measure.emit(OR, -1);
+        }
+    }
+
+    void parseAnd()
+    {
+        parseNot();
+        while (acceptOperator("&&") || acceptOperator("&"))
+        {
+            parseNot();
+            measure.emit(AND, -1);
+        }
+    }
+
+    void parseNot()
+    {
+        if (acceptOperator("!"))
+        {
+            parseNot();
+            measure.emit(NOT, 0);
+        }
+        else
+            parseComparison();
+    }
+
+    void parseComparison()
+    {
+        parseAdditive();
+        OpCode op;
+        if (acceptOperator("<="))
+            op = LE;
+        else if (acceptOperator(">="))
+            op = GE;
+        else if (acceptOperator("=="))
+            op = EQ;
+        else if (acceptOperator("!="))
+            op = NE;
+        else if (acceptOperator("<"))
+            op = LT;
+        else if (acceptOperator(">"))
+            op = GT;
+        else
+            return;
+        parseAdditive();
+        measure.emit(op, -1);
+    }
+
+    void parseAdditive()
+    {
+        parseMultiplicative();
+        while (true)
+        {
+            if (acceptOperator("+"))
+            {
+                parseMultiplicative();
+                measure.emit(ADD, -1);
+            }
+            else if (acceptOperator("-"))
+            {
+                parseMultiplicative();
+                measure.emit(SUB, -1);
+            }
+            else
+                return;
+        }
+    }
+
+    void parseMultiplicative()
+    {
+        parseUnary();
+        while (true)
+        {
+            if (acceptOperator("*"))
+            {
+                parseUnary();
+                measure.emit(MUL, -1);
+            }
+            else if (acceptOperator("/"))
+            {
+                parseUnary();
+                measure.emit(DIV, -1);
+            }
+            else
+                return;
+        }
+    }
+
+    void parseUnary()
+    {
+        if (acceptOperator("-"))
+        {
+            parseUnary();
+            measure.emit(NEG, 0);
+        }
+        else if (acceptOperator("+"))
+            parseUnary();
+        else if (acceptOperator("!"))
+        {
+            //as in R, negation in an operand extends over the rest of the comparison, e.g. 1 + !x > 0
+            parseNot();
+            measure.emit(NOT, 0);
+        }
+        else
+            parsePower();
+    }
+
+    void parsePower()
+    {
+        parsePrimary();
+        if (acceptOperator("^"))
+        {
+            parseUnary();   //right associative, binds stronger than unary minus on the left side only
+            measure.emit(POW, -1);
+        }
+    }
+
+    void parsePrimary()
+    {
+        skipSpaces();
+        if (pos >= text.size())
+            error("unexpected end of the expression");
+        char c = text[pos];
+        if (isdigit(c) || c == '.')
+        {
+            const char* begin = text.c_str() + pos;
+            char* end;
+            double value = strtod(begin, &end);
+            if (end == begin)
+                error("wrong number");
+            pos += end - begin;
+            measure.emit(PUSH_CONST, 1, value);
+        }
+        else if (isalpha(c) || c == '_')
+        {
+            size_t start = pos;
+            while (pos < text.size() && (isalnum(text[pos]) || text[pos] == '_' || text[pos] == '.'))
+                pos++;
+            string name = text.substr(start, pos - start);
+            if (acceptOperator("("))
+                parseFunction(name, start);
+            else
+                parseVariable(name, start);
+        }
+        else if (acceptOperator("("))
+        {
+            parseOr();
+            expect(")");
+        }
+        else
+            error("unexpected symbol");
+    }
+
+    void parseVariable(const string& name, size_t start)
+    {
+        if (name == "P")
+            measure.emit(PUSH_P, 1);
+        else if (name == "p")
+            measure.emit(PUSH_p, 1);
+        else if (name == "N")
+            measure.emit(PUSH_N, 1);
+        else if (name == "n")
+            measure.emit(PUSH_n, 1);
+        else if (name == "pi")
+            measure.emit(PUSH_CONST, 1, 3.14159265358979323846);
+        else if (name == "Inf")
+            measure.emit(PUSH_CONST, 1, numeric_limits<double>::infinity());
+        else
+        {
+            pos = start;
+            error("unknown variable \"" + name + "\"");
+        }
+    }
+
+    void parseFunction(const string& name, size_t start)
+    {
+        int argCount = 0;
+        skipSpaces();
+        if (pos < text.size() && text[pos] != ')')
+        {
+            do
+            {
+                parseOr();
+                argCount++;
+            }
+            while (acceptOperator(","));
+        }
+        expect(")");
+
+        OpCode op;
+        int expectedCount = 1;
+        if (name == "log" && argCount == 2)
+        {
+            op = LOG_BASE;
+            expectedCount = 2;
+        }
+        else if (name == "log")
+            op = LOG;
+        else if (name == "log2")
+            op = LOG2;
+        else if (name == "log10")
+            op = LOG10;
+        else if (name == "exp")
+            op = EXP;
+        else if (name == "sqrt")
+            op = SQRT;
+        else if (name == "abs")
+            op = ABS;
+        else if (name == "lgamma")
+            op = LGAMMA;
+        else if (name == "min" || name == "max")
+        {
+            op = name == "min" ? MIN : MAX;
+            expectedCount = 2;
+        }
+        else if (name == "ifelse")
+        {
+            op = IFELSE;
+            expectedCount = 3;
+        }
+        else
+        {
+            pos = start;
+            error("unknown function \"" + name + "\"");
+        }
+        if (argCount != expectedCount)
+        {
+            pos = start;
+            error("wrong number of arguments of function \"" + name + "\"");
+        }
+        measure.emit(op, 1 - argCount);
+    }
+
+    void skipSpaces()
+    {
+        while (pos < text.size() && isspace(text[pos]))
+            pos++;
+    }
+
+    bool acceptOperator(const char* op)
+    {
+        skipSpaces();
+        size_t length = string(op).size();
+        if (text.compare(pos, length, op) != 0)
+            return false;
+        //"<" must not be taken from "<=" etc.; longer operators are always checked first
+        pos += length;
+        return true;
+    }
+
+    void expect(const char* op)
+    {
+        if (!acceptOperator(op))
+            error(string("\"") + op + "\" expected");
+    }
+
+    void error(const string& message)
+    {
+        ostringstream oss;
+        oss << "Wrong rule quality measure \"" << text << "\": " << message << " at position " << pos + 1;
+        throw RulesInductionException(oss.str());
+    }
+
+    ExpressionMeasure& measure;
+    const string& text;
+    size_t pos;
+};
+
+/**
+ * Compiles the expression
+ * @param expression expression in P, p, N and n
+ */
+ExpressionMeasure::ExpressionMeasure(const string& expression) throw (RulesInductionException)
+    : expression(expression), stackSize(0)
+{
+    Parser parser(*this, this->expression);
+    parser.parse();
+}
+
+void ExpressionMeasure::emit(OpCode op, int stackChange, double value)
+{
+    Instruction instruction;
+    instruction.op = op;
+    instruction.value = value;
+    code.push_back(instruction);
+    stackSize += stackChange;
+    if (stackSize > MAX_STACK_SIZE)
+        throw RulesInductionException("Rule quality measure \"" + expression + "\" is too complex");
+}
+
+namespace
+{
+const double NaN = numeric_limits<double>::quiet_NaN();
+
+/**
+ * Logical value in R style: NaN if any argument is NaN
+ */
+inline double logical(bool value, double a, double b)
+{
+    return a != a || b != b ? NaN : (value ? 1 : 0);
+}
+}
+
+/**
+ * Evaluates the expression for the rule
+ * @param r RuleEvaluationResult object
+ * @return value of the expression
+ */
+double ExpressionMeasure::EvaluateRuleQualityFromResult(RuleEvaluationResult r)
+{
+    double stack[MAX_STACK_SIZE];
+    int top = -1;
+    for (vector<Instruction>::const_iterator it = code.begin(); it != code.end(); it++)
+    {
+        switch (it->op)
+        {
+        case PUSH_CONST: stack[++top] = it->value; break;
+        case PUSH_P: stack[++top] = r.P; break;
+        case PUSH_p: stack[++top] = r.p; break;
+        case PUSH_N: stack[++top] = r.N; break;
+        case PUSH_n: stack[++top] = r.n; break;
+        case NEG: stack[top] = -stack[top]; break;
+        case NOT: stack[top] = stack[top] != stack[top] ? NaN : (stack[top] == 0 ? 1 : 0); break;
+        case ADD: top--; stack[top] += stack[top + 1]; break;
+        case SUB: top--; stack[top] -= stack[top + 1]; break;
+        case MUL: top--; stack[top] *= stack[top + 1]; break;
+        case DIV: top--; stack[top] /= stack[top + 1]; break;
+        case POW: top--; stack[top] = pow(stack[top], stack[top + 1]); break;
+        case LT: top--; stack[top] = logical(stack[top] < stack[top + 1], stack[top], stack[top + 1]); break;
+        case LE: top--; stack[top] = logical(stack[top] <= stack[top + 1], stack[top], stack[top + 1]); break;
+        case GT: top--; stack[top] = logical(stack[top] > stack[top + 1], stack[top], stack[top + 1]); break;
+        case GE: top--; stack[top] = logical(stack[top] >= stack[top + 1], stack[top], stack[top + 1]); break;
+        case EQ: top--; stack[top] = logical(stack[top] == stack[top + 1], stack[top], stack[top + 1]); break;
+        case NE: top--; stack[top] = logical(stack[top] != stack[top + 1], stack[top], stack[top + 1]); break;
+        case AND: top--; stack[top] = logical(stack[top] != 0 && stack[top + 1] != 0, stack[top], stack[top + 1]); break;
+        case OR: top--; stack[top] = logical(stack[top] != 0 || stack[top + 1] != 0, stack[top], stack[top + 1]); break;
+        case LOG: stack[top] = log(stack[top]); break;
+        case LOG_BASE: top--; stack[top] = log(stack[top]) / log(stack[top + 1]); break;
+        case LOG2: stack[top] = Log2(stack[top]); break;
+        case LOG10: stack[top] = log10(stack[top]); break;
+        case EXP: stack[top] = exp(stack[top]); break;
+        case SQRT: stack[top] = sqrt(stack[top]); break;
+        case ABS: stack[top] = fabs(stack[top]); break;
+        case LGAMMA: stack[top] = lgamma(stack[top]); break;
+        case MIN: top--; stack[top] = stack[top] != stack[top] || stack[top + 1] != stack[top + 1] ? NaN : (stack[top + 1] < stack[top] ? stack[top + 1] : stack[top]); break;
+        case MAX: top--; stack[top] = stack[top] != stack[top] || stack[top + 1] != stack[top + 1] ? NaN : (stack[top + 1] > stack[top] ? stack[top + 1] : stack[top]); break;
+        case IFELSE:
+            top -= 2;
+            stack[top] = stack[top] != stack[top] ? NaN : (stack[top] != 0 ? stack[top + 1] : stack[top + 2]);
+            break;
+        }
+    }
+    return stack[0];
+}
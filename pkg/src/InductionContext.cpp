@@ -0,0 +1,26 @@
+#include "InductionContext.h"
+
+using namespace std;
+
+/**
+ * Creates the context of a parallel task. It has the same settings and stream for messages
+ * and its own random number generator, which depends only on this context and the index of the task.
+ * @param stream index of the task
+ * @return context of the task
+ */
+InductionContext InductionContext::split(uint64_t stream) const
+{
+    InductionContext context(*this);
+    context.random = random.split(stream);
+    return context;
+}
+
+/**
+ * Writes the message (as a separate line) to the stream of the context
+ * @param message message
+ */
+void InductionContext::log(const string& message)
+{
+    if (logStream != NULL)
+        *logStream << message << endl;
+}
@@ -0,0 +1,32 @@
+#ifndef INDUCTIONCONTEXT_H
+#define	INDUCTIONCONTEXT_H
+
+#include "RandomGenerator.h"
+#include <stdint.h>
+#include <ostream>
+#include <string>
+
+/**
+ * State of one induction passed explicitly to the algorithms instead of globals: the random number
+ * generator, the stream for messages and the settings of the induction. Algorithms using different
+ * contexts may run in parallel; with the same seed they give the same results.
+ */
+class InductionContext
+{
+public:
+    explicit InductionContext(uint64_t seed = 0) : random(seed), logStream(NULL), growSampleSize(0) {}
+    RandomGenerator& getRandom() { return random; }
+    InductionContext split(uint64_t stream) const;
+    /** messages are written to the stream; they are dropped if it is NULL*/
+    void setLogStream(std::ostream* stream) { logStream = stream; }
+    void log(const std::string& message);
+    /** rules are grown on samples with at most that many negative examples (0 - on all the examples)*/
+    int getGrowSampleSize() const { return growSampleSize; }
+    void setGrowSampleSize(int size) { growSampleSize = size; }
+private:
+    RandomGenerator random;
+    std::ostream* logStream;
+    int growSampleSize; /**< maximal number of negative examples used in the growth of a rule, 0 if not limited*/
+};
+
+#endif	/* INDUCTIONCONTEXT_H */
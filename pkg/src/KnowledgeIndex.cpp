@@ -0,0 +1,282 @@
+#include "KnowledgeIndex.h"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+/**
+ * Compiles the knowledge
+ * @param knowledge knowledge
+ * @param ds data set the rules are induced from
+ */
+void KnowledgeIndex::build(Knowledge& knowledge, DataSet& ds)
+{
+    attributes.resize(knowledge.getNumberOfClasses());
+    for (int decClass = 0; decClass < knowledge.getNumberOfClasses(); decClass++)
+        update(knowledge, ds, decClass);
+}
+
+/**
+ * Compiles again the knowledge of one class (after its conditions were changed)
+ * @param knowledge knowledge
+ * @param ds data set the rules are induced from
+ * @param decClass decision class
+ */
+void KnowledgeIndex::update(Knowledge& knowledge, DataSet& ds, double decClass)
+{
+    int numberOfAttributes = ds.getAttributes().size() - 1;
+    vector<AttributeKnowledge>& classKnowledge = attributes[(size_t)decClass];
+    classKnowledge.assign(numberOfAttributes, AttributeKnowledge());
+    for (int i = 0; i < numberOfAttributes; i++)
+    {
+        AttributeKnowledge& att = classKnowledge[i];
+        size_t numberOfLevels = ds.getConditionalAttribute(i).getLevels().size();
+        att.specifiedLevels[0].init(numberOfLevels);
+        att.specifiedLevels[1].init(numberOfLevels);
+        att.forbiddenLevels.init(numberOfLevels);
+        att.forbiddenGreaterEqualBelow = -numeric_limits<double>::infinity();
+        att.forbiddenLessThanAbove = numeric_limits<double>::infinity();
+    }
+
+    //conditions on attributes out of the data set are never checked
+    list<KnowledgeCondition>& allowed = knowledge.getAllowedConditions()[(size_t)decClass].getConditions();
+    for (list<KnowledgeCondition>::iterator it = allowed.begin(); it != allowed.end(); it++)
+        if (it->getAttributeIndex() >= 0 && it->getAttributeIndex() < numberOfAttributes)
+        {
+            classKnowledge[it->getAttributeIndex()].allowed.push_back(*it);
+            addSpecifiedCondition(classKnowledge[it->getAttributeIndex()], *it);
+        }
+    list<KnowledgeCondition>& forbidden = knowledge.getForbiddenConditions()[(size_t)decClass].getConditions();
+    for (list<KnowledgeCondition>::iterator it = forbidden.begin(); it != forbidden.end(); it++)
+        if (it->getAttributeIndex() >= 0 && it->getAttributeIndex() < numberOfAttributes)
+            addForbiddenCondition(classKnowledge[it->getAttributeIndex()], *it);
+    list<KnowledgeRule>& forbiddenRules = knowledge.getForbiddenRules()[(size_t)decClass];
+    for (list<KnowledgeRule>::iterator rule = forbiddenRules.begin(); rule != forbiddenRules.end(); rule++)
+    {
+        list<KnowledgeCondition>& conditions = rule->getConditions().getConditions();
+        for (list<KnowledgeCondition>::iterator it = conditions.begin(); it != conditions.end(); it++)
+        {
+            if (it->getAttributeIndex() < 0 || it->getAttributeIndex() >= numberOfAttributes)
+                continue;
+            vector<KnowledgeRule*>& rules = classKnowledge[it->getAttributeIndex()].forbiddenRules;
+            if (rules.empty() || rules.back() != &*rule)
+                rules.push_back(&*rule);
+        }
+    }
+
+    for (int i = 0; i < numberOfAttributes; i++)
+    {
+        AttributeKnowledge& att = classKnowledge[i];
+        for (int required = 0; required < 2; required++)
+        {
+            att.specifiedGreaterEqual[required].compile(true);
+            att.specifiedLessThan[required].compile(false);
+            att.specifiedLevels[required].compile();
+        }
+        sort(att.forbiddenGreaterEqual.begin(), att.forbiddenGreaterEqual.end());
+        sort(att.forbiddenLessThan.begin(), att.forbiddenLessThan.end());
+        att.forbiddenLevels.compile();
+    }
+}
+
+/**
+ * Adds the thresholds and levels satisfying an allowed condition. A condition "attribute >= value"
+ * is specified by a fixed condition with the same lower bound (or with unbounded lower bound and a greater
+ * upper bound) and by a condition which is not fixed with the value in [from, to). Conditions "attribute < value"
+ * are the reverse (the value in (from, to]).
+ * @param att knowledge on the attribute
+ * @param cond allowed condition
+ */
+void KnowledgeIndex::addSpecifiedCondition(AttributeKnowledge& att, KnowledgeCondition& cond)
+{
+    double from = cond.getFrom(), to = cond.getTo(), value = cond.getValue();
+    for (int required = 0; required < 2; required++)
+    {
+        if (required && !cond.isRequired())
+            continue;
+        if (cond.isFixed())
+        {
+            att.specifiedGreaterEqual[required].addValue(from);
+            if (from == -numeric_limits<double>::infinity())
+                att.specifiedGreaterEqual[required].addInterval(from, to);
+            att.specifiedLessThan[required].addValue(to);
+            if (to == numeric_limits<double>::infinity() && from == from)
+            {
+                //every value not greater than the lower bound
+                att.specifiedLessThan[required].addValue(-numeric_limits<double>::infinity());
+                att.specifiedLessThan[required].addInterval(-numeric_limits<double>::infinity(), from);
+            }
+        }
+        else
+        {
+            att.specifiedGreaterEqual[required].addInterval(from, to);
+            att.specifiedLessThan[required].addInterval(from, to);
+        }
+        if (value == value)
+            att.specifiedLevels[required].add(value);
+    }
+}
+
+/**
+ * Adds the thresholds and levels forbidden by a condition. A fixed condition forbids conditions with
+ * the same thresholds, other conditions forbid all the conditions intersecting with them.
+ * @param att knowledge on the attribute
+ * @param cond forbidden condition
+ */
+void KnowledgeIndex::addForbiddenCondition(AttributeKnowledge& att, KnowledgeCondition& cond)
+{
+    double from = cond.getFrom(), to = cond.getTo(), value = cond.getValue();
+    if (cond.isFixed())
+    {
+        if (from == from)
+            att.forbiddenGreaterEqual.push_back(from);
+        if (to == to)
+            att.forbiddenLessThan.push_back(to);
+    }
+    else
+    {
+        if (to > att.forbiddenGreaterEqualBelow)
+            att.forbiddenGreaterEqualBelow = to;
+        if (from < att.forbiddenLessThanAbove)
+            att.forbiddenLessThanAbove = from;
+    }
+    if (value == value)
+        att.forbiddenLevels.add(value);
+}
+
+/**
+ * Checks if a numerical condition is specified by the allowed conditions
+ * @param decClass decision class
+ * @param attributeIndex index of the attribute
+ * @param value threshold of the condition
+ * @param greaterEqual true for a condition "attribute >= value", false for "attribute < value"
+ * @param andRequired true if only required conditions are taken into account
+ * @return true if the condition is specified
+ */
+bool KnowledgeIndex::isNumericConditionSpecified(double decClass, int attributeIndex, double value, bool greaterEqual, bool andRequired) const
+{
+    const AttributeKnowledge& att = attributes[(size_t)decClass][attributeIndex];
+    return greaterEqual ? att.specifiedGreaterEqual[andRequired].contains(value) : att.specifiedLessThan[andRequired].contains(value);
+}
+
+/**
+ * Checks if a numerical condition is forbidden by the forbidden conditions (forbidden rules are not checked)
+ * @param decClass decision class
+ * @param attributeIndex index of the attribute
+ * @param value threshold of the condition
+ * @param greaterEqual true for a condition "attribute >= value", false for "attribute < value"
+ * @return true if the condition is forbidden
+ */
+bool KnowledgeIndex::isNumericConditionForbidden(double decClass, int attributeIndex, double value, bool greaterEqual) const
+{
+    const AttributeKnowledge& att = attributes[(size_t)decClass][attributeIndex];
+    if (greaterEqual)
+        return value < att.forbiddenGreaterEqualBelow || containsValue(att.forbiddenGreaterEqual, value);
+    return value > att.forbiddenLessThanAbove || containsValue(att.forbiddenLessThan, value);
+}
+
+/**
+ * Checks if a nominal condition is specified by the allowed conditions
+ * @param decClass decision class
+ * @param attributeIndex index of the attribute
+ * @param value value of the condition
+ * @param andRequired true if only required conditions are taken into account
+ * @return true if the condition is specified
+ */
+bool KnowledgeIndex::isNominalConditionSpecified(double decClass, int attributeIndex, double value, bool andRequired) const
+{
+    return attributes[(size_t)decClass][attributeIndex].specifiedLevels[andRequired].contains(value);
+}
+
+/**
+ * Checks if a nominal condition is forbidden by the forbidden conditions (forbidden rules are not checked)
+ * @param decClass decision class
+ * @param attributeIndex index of the attribute
+ * @param value value of the condition
+ * @return true if the condition is forbidden
+ */
+bool KnowledgeIndex::isNominalConditionForbidden(double decClass, int attributeIndex, double value) const
+{
+    return attributes[(size_t)decClass][attributeIndex].forbiddenLevels.contains(value);
+}
+
+bool KnowledgeIndex::containsValue(const vector<double>& sorted, double value)
+{
+    vector<double>::const_iterator it = lower_bound(sorted.begin(), sorted.end(), value);
+    return it != sorted.end() && *it == value;
+}
+
+void KnowledgeIndex::ThresholdSet::addValue(double value)
+{
+    if (value == value)
+        values.push_back(value);
+}
+
+/**
+ * Sorts the values and merges the intervals
+ * @param leftClosed true for intervals [from, to), false for (from, to]
+ */
+void KnowledgeIndex::ThresholdSet::compile(bool leftClosed)
+{
+    this->leftClosed = leftClosed;
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+
+    vector<pair<double, double> > sorted;
+    for (size_t i = 0; i < intervals.size(); i++)
+        if (intervals[i].first < intervals[i].second)   //false for empty intervals and NaN bounds
+            sorted.push_back(intervals[i]);
+    sort(sorted.begin(), sorted.end());
+    intervals.clear();
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        if (!intervals.empty() && sorted[i].first <= intervals.back().second)
+            intervals.back().second = max(intervals.back().second, sorted[i].second);
+        else
+            intervals.push_back(sorted[i]);
+    }
+}
+
+bool KnowledgeIndex::ThresholdSet::contains(double value) const
+{
+    if (!intervals.empty())
+    {
+        //the last interval starting before the value
+        vector<pair<double, double> >::const_iterator it;
+        if (leftClosed)
+        {
+            it = upper_bound(intervals.begin(), intervals.end(), value,
+                    [](double v, const pair<double, double>& interval) { return v < interval.first; });
+            if (it != intervals.begin() && value < (--it)->second)
+                return true;
+        }
+        else
+        {
+            it = lower_bound(intervals.begin(), intervals.end(), value,
+                    [](const pair<double, double>& interval, double v) { return interval.first < v; });
+            if (it != intervals.begin() && value <= (--it)->second)
+                return true;
+        }
+    }
+    return containsValue(values, value);
+}
+
+void KnowledgeIndex::LevelSet::add(double value)
+{
+    if (value >= 0 && value < bitmap.size() && value == (size_t)value)
+        bitmap[(size_t)value] = 1;
+    else if (value == value)
+        others.push_back(value);
+}
+
+void KnowledgeIndex::LevelSet::compile()
+{
+    sort(others.begin(), others.end());
+}
+
+bool KnowledgeIndex::LevelSet::contains(double value) const
+{
+    if (value >= 0 && value < bitmap.size() && value == (size_t)value)
+        return bitmap[(size_t)value] != 0;
+    return containsValue(others, value);
+}
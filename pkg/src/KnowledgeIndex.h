@@ -0,0 +1,97 @@
+#ifndef KNOWLEDGEINDEX_H
+#define	KNOWLEDGEINDEX_H
+
+#include "Knowledge.h"
+#include "KnowledgeCondition.h"
+#include "KnowledgeRule.h"
+#include "DataSet.h"
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+/**
+ * Knowledge compiled for the induction with preferences. Conditions of the knowledge are grouped
+ * by decision class and attribute once, before the induction, so the checks of candidate conditions
+ * do not walk (and copy) the lists of all the conditions of the class:
+ *  - allowed numerical conditions are merged into sorted arrays of intervals of thresholds,
+ *  - forbidden numerical conditions are reduced to the bounds of the forbidden ranges of thresholds
+ *    (and sorted arrays of the thresholds of fixed conditions),
+ *  - nominal conditions are bitmaps of levels,
+ *  - forbidden rules are listed for every attribute they contain a condition on.
+ * The checks give the same answers as the checks of the lists of conditions.
+ */
+class KnowledgeIndex
+{
+public:
+    void build(Knowledge& knowledge, DataSet& ds);
+    void update(Knowledge& knowledge, DataSet& ds, double decClass);
+    bool isNumericConditionSpecified(double decClass, int attributeIndex, double value, bool greaterEqual, bool andRequired = false) const;
+    bool isNumericConditionForbidden(double decClass, int attributeIndex, double value, bool greaterEqual) const;
+    bool isNominalConditionSpecified(double decClass, int attributeIndex, double value, bool andRequired = false) const;
+    bool isNominalConditionForbidden(double decClass, int attributeIndex, double value) const;
+    /** @return allowed conditions of the class on the attribute, in the order of the knowledge*/
+    const std::vector<KnowledgeCondition>& getAllowedConditions(double decClass, int attributeIndex) const
+    {
+        return attributes[(std::size_t)decClass][attributeIndex].allowed;
+    }
+    /** @return forbidden rules of the class with a condition on the attribute, in the order of the knowledge*/
+    const std::vector<KnowledgeRule*>& getForbiddenRules(double decClass, int attributeIndex) const
+    {
+        return attributes[(std::size_t)decClass][attributeIndex].forbiddenRules;
+    }
+private:
+    /**
+     * Set of thresholds: union of intervals closed on one side and of single values
+     */
+    class ThresholdSet
+    {
+    public:
+        ThresholdSet() : leftClosed(true) {}
+        void addInterval(double from, double to) { intervals.push_back(std::make_pair(from, to)); }
+        void addValue(double value);
+        void compile(bool leftClosed);
+        bool contains(double value) const;
+    private:
+        std::vector<std::pair<double, double> > intervals; /**< disjoint intervals [from, to) or (from, to], sorted*/
+        std::vector<double> values;                        /**< sorted single values*/
+        bool leftClosed;
+    };
+
+    /**
+     * Set of levels of a nominal attribute: bitmap of the levels which are indices of the values
+     * of the attribute and sorted array of other values
+     */
+    class LevelSet
+    {
+    public:
+        void init(std::size_t numberOfLevels) { bitmap.assign(numberOfLevels, 0); }
+        void add(double value);
+        void compile();
+        bool contains(double value) const;
+    private:
+        std::vector<char> bitmap;
+        std::vector<double> others;
+    };
+
+    struct AttributeKnowledge
+    {
+        std::vector<KnowledgeCondition> allowed;
+        ThresholdSet specifiedGreaterEqual[2];      /**< thresholds of allowed conditions "attribute >= value" (all, required)*/
+        ThresholdSet specifiedLessThan[2];          /**< thresholds of allowed conditions "attribute < value" (all, required)*/
+        LevelSet specifiedLevels[2];                /**< levels of allowed conditions (all, required)*/
+        double forbiddenGreaterEqualBelow;          /**< conditions "attribute >= value" with lower thresholds are forbidden*/
+        double forbiddenLessThanAbove;              /**< conditions "attribute < value" with greater thresholds are forbidden*/
+        std::vector<double> forbiddenGreaterEqual;  /**< sorted forbidden thresholds of fixed conditions "attribute >= value"*/
+        std::vector<double> forbiddenLessThan;      /**< sorted forbidden thresholds of fixed conditions "attribute < value"*/
+        LevelSet forbiddenLevels;
+        std::vector<KnowledgeRule*> forbiddenRules;
+    };
+
+    void addSpecifiedCondition(AttributeKnowledge& att, KnowledgeCondition& cond);
+    void addForbiddenCondition(AttributeKnowledge& att, KnowledgeCondition& cond);
+    static bool containsValue(const std::vector<double>& sorted, double value);
+
+    std::vector<std::vector<AttributeKnowledge> > attributes;    /**< knowledge of every class on every attribute*/
+};
+
+#endif	/* KNOWLEDGEINDEX_H */
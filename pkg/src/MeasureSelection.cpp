@@ -0,0 +1,279 @@
+#include "MeasureSelection.h"
+#include "SequentialCovering.h"
+#include "RuleClassifier.h"
+#include "ConfusionMatrix.h"
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+using namespace std;
+
+/**
+ * Adds a split of the data set; all the pairs are evaluated on the same splits
+ * @param trainSet training set
+ * @param testSet test set
+ */
+void MeasureSelection::addSplit(const SetOfExamples& trainSet, const SetOfExamples& testSet)
+{
+    trainSets.push_back(trainSet);
+    testSets.push_back(testSet);
+    for (size_t i = 0; i < results.size(); i++)
+        results[i].resize(trainSets.size());
+}
+
+/**
+ * Adds a pair of measures to be evaluated. The measures are not copied nor deleted.
+ * @param rqmGrow rule quality measure used in the growth of rules
+ * @param rqmPrune rule quality measure used in the pruning of rules
+ * @param threadSafe true if the measures may be used by many threads at once
+ * @return index of the pair
+ */
+int MeasureSelection::addPair(RuleQualityMeasure* rqmGrow, RuleQualityMeasure* rqmPrune, bool threadSafe)
+{
+    Pair pair;
+    pair.rqmGrow = rqmGrow;
+    pair.rqmPrune = rqmPrune;
+    pair.threadSafe = threadSafe;
+    pairs.push_back(pair);
+    results.push_back(vector<SplitResult>(trainSets.size()));
+    return pairs.size() - 1;
+}
+
+/**
+ * Evaluates all the pairs on all the splits
+ */
+void MeasureSelection::evaluate() throw (RulesInductionException)
+{
+    vector<int> pairIndices;
+    for (int i = 0; i < getNumberOfPairs(); i++)
+        pairIndices.push_back(i);
+    evaluate(pairIndices, getNumberOfSplits());
+}
+
+/**
+ * Evaluates the given pairs on the first splits; splits the pairs were already evaluated on are skipped
+ * @param pairIndices indices of the pairs
+ * @param numberOfSplits number of the splits
+ */
+void MeasureSelection::evaluate(const vector<int>& pairIndices, int numberOfSplits) throw (RulesInductionException)
+{
+    vector<pair<int, int> > parallelTasks, serialTasks;
+    for (size_t i = 0; i < pairIndices.size(); i++)
+        for (int split = 0; split < numberOfSplits && split < getNumberOfSplits(); split++)
+        {
+            int pair = pairIndices[i];
+            if (results[pair][split].evaluated)
+                continue;
+            if (pairs[pair].threadSafe)
+                parallelTasks.push_back(make_pair(pair, split));
+            else
+                serialTasks.push_back(make_pair(pair, split));
+        }
+
+    //exceptions cannot leave the parallel loop, the first one is thrown after the loop
+    string error;
+    bool failed = false;
+    int size = parallelTasks.size();
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < size; i++)
+    {
+        try
+        {
+            evaluate(parallelTasks[i].first, parallelTasks[i].second);
+        }
+        catch (RulesInductionException& ex)
+        {
+            #pragma omp critical
+            if (!failed)
+            {
+                failed = true;
+                error = ex.getMessage();
+            }
+        }
+        catch (exception& ex)
+        {
+            #pragma omp critical
+            if (!failed)
+            {
+                failed = true;
+                error = ex.what();
+            }
+        }
+        catch (...)
+        {
+            #pragma omp critical
+            if (!failed)
+            {
+                failed = true;
+                error = "Unknown error in the evaluation of a pair of measures";
+            }
+        }
+    }
+    if (failed)
+        throw RulesInductionException(error);
+
+    for (size_t i = 0; i < serialTasks.size(); i++)
+        evaluate(serialTasks[i].first, serialTasks[i].second);
+}
+
+/**
+ * Races the pairs by successive halving: all the pairs are evaluated on the first initialSplits splits,
+ * then the best 1/factor of them are evaluated on factor times more splits and so on. The last pairs
+ * are evaluated on all the splits; pairs discarded earlier keep the criteria from fewer splits.
+ * @param criterion criterion used to rank the pairs
+ * @param initialSplits number of the splits in the first round
+ * @param factor ratio of the numbers of the splits (and of the pairs) in successive rounds
+ */
+void MeasureSelection::race(Criterion criterion, int initialSplits, double factor) throw (RulesInductionException)
+{
+    if (factor <= 1)
+        throw RulesInductionException("Factor of racing has to be greater than one");
+    vector<int> survivors;
+    for (int i = 0; i < getNumberOfPairs(); i++)
+        survivors.push_back(i);
+    int splits = min(max(initialSplits, 1), getNumberOfSplits());
+    while (!survivors.empty())
+    {
+        evaluate(survivors, splits);
+        if (splits >= getNumberOfSplits())
+            break;
+        //NaN is the worst value; pairs with equal criteria keep their order
+        vector<pair<double, int> > ranking;
+        for (size_t i = 0; i < survivors.size(); i++)
+        {
+            double value = getCriterion(survivors[i], criterion);
+            ranking.push_back(make_pair(value == value ? value : -numeric_limits<double>::infinity(), survivors[i]));
+        }
+        stable_sort(ranking.begin(), ranking.end(),
+                [](const pair<double, int>& a, const pair<double, int>& b) { return a.first > b.first; });
+        size_t kept = max((size_t)1, (size_t)ceil(survivors.size() / factor));
+        survivors.clear();
+        for (size_t i = 0; i < kept; i++)
+            survivors.push_back(ranking[i].second);
+        sort(survivors.begin(), survivors.end());
+        //the only pair left is evaluated on all the splits at once
+        splits = kept == 1 ? getNumberOfSplits() : min(getNumberOfSplits(), (int)ceil(splits * factor));
+    }
+}
+
+/**
+ * Induces rules on the training set of the split and classifies the test set
+ * @param pair index of the pair of measures
+ * @param split index of the split
+ */
+void MeasureSelection::evaluate(int pair, int split)
+{
+    InductionContext taskContext(context.split(((uint64_t)pair << 32) | (uint64_t)split));
+    SequentialCovering sc(taskContext);
+    SetOfExamples trainSet(trainSets[split]);
+    SetOfExamples testSet(testSets[split]);
+    RuleClassifier ruleClassifier(sc.generateRules(trainSet, *pairs[pair].rqmGrow, *pairs[pair].rqmPrune));
+    vector<double> predictions = ruleClassifier.classifyExamples(testSet);
+    ConfusionMatrix cm(0);
+    if (useWeightsInPrediction)
+        cm = ruleClassifier.generateConfusionMatrixWithWeights(testSet, predictions);
+    else
+        cm = ruleClassifier.generateConfusionMatrix(testSet, predictions);
+
+    SplitResult& result = results[pair][split];
+    result.accuracy = ruleClassifier.evaluateAccuracy(cm);
+    result.avgAccuracy = ruleClassifier.evaluateAvgAccuracy(ruleClassifier.evaluateClassesAccuracy(cm));
+    result.confusionMatrix = cm.getMatrix();
+    result.evaluated = true;
+}
+
+/**
+ * @param pair index of the pair of measures
+ * @return number of the splits the pair was evaluated on
+ */
+int MeasureSelection::getNumberOfEvaluatedSplits(int pair) const
+{
+    int count = 0;
+    for (size_t i = 0; i < results[pair].size(); i++)
+        if (results[pair][i].evaluated)
+            count++;
+    return count;
+}
+
+/**
+ * @param pair index of the pair of measures
+ * @return mean classification accuracy over the evaluated splits
+ */
+double MeasureSelection::getAccuracy(int pair) const
+{
+    double sum = 0;
+    int count = 0;
+    for (size_t i = 0; i < results[pair].size(); i++)
+        if (results[pair][i].evaluated)
+        {
+            sum += results[pair][i].accuracy;
+            count++;
+        }
+    return count > 0 ? sum / count : numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * @param pair index of the pair of measures
+ * @return mean of the average accuracies of classes over the evaluated splits
+ */
+double MeasureSelection::getAvgAccuracy(int pair) const
+{
+    double sum = 0;
+    int count = 0;
+    for (size_t i = 0; i < results[pair].size(); i++)
+        if (results[pair][i].evaluated)
+        {
+            sum += results[pair][i].avgAccuracy;
+            count++;
+        }
+    return count > 0 ? sum / count : numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * Computes geometric mean of the accuracies of two classes from the confusion matrix summed over
+ * the evaluated splits
+ * @param pair index of the pair of measures
+ * @return g-mean, NaN if the data set does not have two classes
+ */
+double MeasureSelection::getGmean(int pair) const
+{
+    double cm[2][2] = {{0, 0}, {0, 0}};
+    int count = 0;
+    for (size_t i = 0; i < results[pair].size(); i++)
+    {
+        const SplitResult& result = results[pair][i];
+        if (!result.evaluated)
+            continue;
+        if (result.confusionMatrix.size() != 2)
+            return numeric_limits<double>::quiet_NaN();
+        for (int actual = 0; actual < 2; actual++)
+            for (int predicted = 0; predicted < 2; predicted++)
+                cm[actual][predicted] += result.confusionMatrix[actual][predicted];
+        count++;
+    }
+    if (count == 0)
+        return numeric_limits<double>::quiet_NaN();
+    double accPlus = cm[0][0] / (cm[0][0] + cm[0][1]);
+    double accMinus = cm[1][1] / (cm[1][1] + cm[1][0]);
+    return sqrt(accMinus * accPlus);
+}
+
+/**
+ * @param pair index of the pair of measures
+ * @param criterion criterion
+ * @return value of the criterion for the pair
+ */
+double MeasureSelection::getCriterion(int pair, Criterion criterion) const
+{
+    switch (criterion)
+    {
+        case ACCURACY:
+            return getAccuracy(pair);
+        case AVG_ACCURACY:
+            return getAvgAccuracy(pair);
+        default:
+            return getGmean(pair);
+    }
+}
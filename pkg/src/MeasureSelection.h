@@ -0,0 +1,70 @@
+#ifndef MEASURESELECTION_H
+#define	MEASURESELECTION_H
+
+#include "SetOfExamples.h"
+#include "RuleQualityMeasure.h"
+#include "RulesInductionException.h"
+#include "InductionContext.h"
+#include <vector>
+#include <string>
+
+/**
+ * Evaluates pairs of rule quality measures (for growth and pruning) on common splits of the data set
+ * into training and test sets (folds of cross-validation or a validation set). The data set and the splits
+ * are created once for all the pairs. Pairs are evaluated in parallel (OpenMP), except for the pairs with
+ * measures which are not thread-safe (e.g. defined in R); those are evaluated in the calling thread.
+ * Criteria of a pair are averaged over the splits it was evaluated on. Every pair and split is induced
+ * with its own random number generator split from the context, so results do not depend on the threads.
+ * In racing (successive halving) all the pairs are evaluated on a few splits, only the best of them
+ * are evaluated on more splits and so on, until the remaining pairs are evaluated on all the splits.
+ */
+class MeasureSelection
+{
+public:
+    enum Criterion
+    {
+        ACCURACY,
+        AVG_ACCURACY,
+        GMEAN
+    };
+
+    MeasureSelection(const InductionContext& context) : context(context), useWeightsInPrediction(true) {}
+    void setUseWeightsInPrediction(bool use) { useWeightsInPrediction = use; }
+    void addSplit(const SetOfExamples& trainSet, const SetOfExamples& testSet);
+    int addPair(RuleQualityMeasure* rqmGrow, RuleQualityMeasure* rqmPrune, bool threadSafe);
+    int getNumberOfSplits() const { return trainSets.size(); }
+    int getNumberOfPairs() const { return pairs.size(); }
+    void evaluate() throw (RulesInductionException);
+    void evaluate(const std::vector<int>& pairIndices, int numberOfSplits) throw (RulesInductionException);
+    void race(Criterion criterion, int initialSplits, double factor) throw (RulesInductionException);
+    int getNumberOfEvaluatedSplits(int pair) const;
+    double getAccuracy(int pair) const;
+    double getAvgAccuracy(int pair) const;
+    double getGmean(int pair) const;
+    double getCriterion(int pair, Criterion criterion) const;
+private:
+    struct Pair
+    {
+        RuleQualityMeasure* rqmGrow;
+        RuleQualityMeasure* rqmPrune;
+        bool threadSafe;    /**< false if the measures have to be called from the calling thread*/
+    };
+    struct SplitResult
+    {
+        SplitResult() : evaluated(false), accuracy(0), avgAccuracy(0) {}
+        bool evaluated;
+        double accuracy;
+        double avgAccuracy;
+        std::vector<std::vector<double> > confusionMatrix;
+    };
+    void evaluate(int pair, int split);
+
+    std::vector<SetOfExamples> trainSets;
+    std::vector<SetOfExamples> testSets;
+    std::vector<Pair> pairs;
+    std::vector<std::vector<SplitResult> > results;   /**< results of every pair on every split*/
+    InductionContext context;   /**< context the contexts of the evaluations are split from*/
+    bool useWeightsInPrediction;
+};
+
+#endif	/* MEASURESELECTION_H */
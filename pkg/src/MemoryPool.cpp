@@ -0,0 +1,425 @@
+#include "MemoryPool.h"
+#include <cstdlib>
+#include <sstream>
+#ifdef CRULES_COUNT_ALLOCATIONS
+#include <atomic>
+#endif
+
+using namespace std;
+
+MemoryPool::MemoryPool() : currentChunk(0), chunkPtr(NULL), chunkEnd(NULL)
+{
+#ifdef CRULES_COUNT_ALLOCATIONS
+    liveBlocks = 0;
+#endif
+    for (size_t i = 0; i < SIZE_CLASSES; i++)
+        freeLists[i] = NULL;
+}
+
+MemoryPool::~MemoryPool()
+{
+    for (size_t i = 0; i < chunks.size(); i++)
+        ::operator delete(chunks[i]);
+}
+
+/**
+ * Allocates memory block
+ * @param bytes size of the block
+ * @return pointer to the block
+ */
+void* MemoryPool::allocate(size_t bytes)
+{
+#ifdef CRULES_COUNT_ALLOCATIONS
+    liveBlocks++;
+#endif
+    size_t sizeClass = bytes == 0 ? 0 : (bytes - 1) / GRANULARITY;
+    if (sizeClass >= SIZE_CLASSES)
+        return ::operator new(bytes);
+
+    if (freeLists[sizeClass] != NULL)
+    {
+        FreeBlock* block = freeLists[sizeClass];
+        freeLists[sizeClass] = block->next;
+        return block;
+    }
+
+    size_t blockSize = (sizeClass + 1) * GRANULARITY;
+    if (chunkPtr == NULL || chunkPtr + blockSize > chunkEnd)
+    {
+        if (chunkPtr != NULL)
+            currentChunk++;
+        if (currentChunk == chunks.size())
+            chunks.push_back(static_cast<char*>(::operator new(CHUNK_SIZE)));
+        chunkPtr = chunks[currentChunk];
+        chunkEnd = chunkPtr + CHUNK_SIZE;
+    }
+    void* result = chunkPtr;
+    chunkPtr += blockSize;
+    return result;
+}
+
+/**
+ * Returns memory block to the pool
+ * @param ptr pointer to the block
+ * @param bytes size of the block (the same as passed to allocate)
+ */
+void MemoryPool::deallocate(void* ptr, size_t bytes)
+{
+#ifdef CRULES_COUNT_ALLOCATIONS
+    liveBlocks--;
+#endif
+    size_t sizeClass = bytes == 0 ? 0 : (bytes - 1) / GRANULARITY;
+    if (sizeClass >= SIZE_CLASSES)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+}
+
+/**
+ * Makes all the memory of the pool available again without returning it to the system.
+ * No object allocated from the pool may be alive when this method is called (checked only when
+ * the package is compiled with CRULES_COUNT_ALLOCATIONS).
+ */
+void MemoryPool::reset() throw (RulesInductionException)
+{
+#ifdef CRULES_COUNT_ALLOCATIONS
+    if (liveBlocks != 0)
+        throw RulesInductionException("Memory pool reset while its blocks are in use");
+#endif
+    for (size_t i = 0; i < SIZE_CLASSES; i++)
+        freeLists[i] = NULL;
+    currentChunk = 0;
+    chunkPtr = NULL;
+    chunkEnd = NULL;
+}
+
+namespace
+{
+/*
+ * Per-thread caches. Objects may still be released after the cache of the thread has been
+ * destroyed (at the exit of the thread), so every cache remembers it in a trivially
+ * destructible flag and then the memory is freed directly.
+ */
+thread_local bool fixedSizeCacheDestroyed = false;
+thread_local bool indexBufferCacheDestroyed = false;
+
+struct FixedSizeCache
+{
+    FixedSizeCache() : head(NULL), size(0) {}
+    ~FixedSizeCache()
+    {
+        clear();
+        fixedSizeCacheDestroyed = true;
+    }
+    void clear()
+    {
+        while (head != NULL)
+        {
+            void* next = *static_cast<void**>(head);
+            ::operator delete(head);
+            head = next;
+        }
+        size = 0;
+    }
+    void* head;
+    size_t size;    /**< number of blocks on the list*/
+};
+
+struct IndexBufferCache
+{
+    IndexBufferCache() : bytes(0) {}
+    ~IndexBufferCache() { indexBufferCacheDestroyed = true; }
+    vector<vector<int> > buffers;
+    size_t bytes;   /**< total capacity of the buffers in bytes*/
+};
+
+thread_local FixedSizeCache fixedSizeCache;
+thread_local IndexBufferCache indexBufferCache;
+
+const size_t MAX_POOLED_INDEX_BUFFER = 1 << 18;
+}
+
+void* FixedSizeAllocator::allocate(size_t bytes)
+{
+    if (bytes > BLOCK_SIZE || fixedSizeCacheDestroyed || fixedSizeCache.head == NULL)
+        return ::operator new(bytes > BLOCK_SIZE ? bytes : BLOCK_SIZE);
+    void* block = fixedSizeCache.head;
+    fixedSizeCache.head = *static_cast<void**>(block);
+    fixedSizeCache.size--;
+    return block;
+}
+
+void FixedSizeAllocator::deallocate(void* ptr, size_t bytes)
+{
+    if (ptr == NULL)
+        return;
+    if (bytes > BLOCK_SIZE || fixedSizeCacheDestroyed || fixedSizeCache.size >= MAX_FREE_BLOCKS)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    *static_cast<void**>(ptr) = fixedSizeCache.head;
+    fixedSizeCache.head = ptr;
+    fixedSizeCache.size++;
+}
+
+/**
+ * Frees the blocks kept by the calling thread
+ */
+void FixedSizeAllocator::clear()
+{
+    if (!fixedSizeCacheDestroyed)
+        fixedSizeCache.clear();
+}
+
+/**
+ * Replaces content of the buffer by an empty buffer from the cache (if there is any)
+ * @param buffer buffer to be replaced
+ */
+void IndexBufferPool::acquire(vector<int>& buffer)
+{
+    if (indexBufferCacheDestroyed || indexBufferCache.buffers.empty())
+        return;
+    buffer.swap(indexBufferCache.buffers.back());
+    indexBufferCache.buffers.pop_back();
+    indexBufferCache.bytes -= buffer.capacity() * sizeof(int);
+    buffer.clear();
+}
+
+/**
+ * Moves the buffer to the cache. Very large buffers and buffers exceeding the limit of the cache are not cached.
+ * @param buffer buffer to be released; it is empty after the call
+ */
+void IndexBufferPool::release(vector<int>& buffer)
+{
+    size_t bytes = buffer.capacity() * sizeof(int);
+    if (indexBufferCacheDestroyed || buffer.capacity() == 0 || buffer.capacity() > MAX_POOLED_INDEX_BUFFER
+            || indexBufferCache.buffers.size() >= MAX_BUFFERS || indexBufferCache.bytes + bytes > MAX_CACHED_BYTES)
+        return;
+    indexBufferCache.buffers.push_back(vector<int>());
+    indexBufferCache.buffers.back().swap(buffer);
+    indexBufferCache.bytes += bytes;
+}
+
+/**
+ * Frees the buffers kept by the calling thread
+ */
+void IndexBufferPool::clear()
+{
+    if (indexBufferCacheDestroyed)
+        return;
+    vector<vector<int> >().swap(indexBufferCache.buffers);
+    indexBufferCache.bytes = 0;
+}
+
+/**
+ * Frees the caches of the calling thread and of the threads of OpenMP (the threads outside of the team
+ * keep their caches, which are limited anyway)
+ */
+void ThreadCachesScope::release()
+{
+    #pragma omp parallel
+    {
+        FixedSizeAllocator::clear();
+        IndexBufferPool::clear();
+    }
+}
+
+#ifdef CRULES_COUNT_ALLOCATIONS
+namespace
+{
+atomic<unsigned long> allocationCounts[AllocationCounter::NUMBER_OF_PHASES];
+thread_local AllocationCounter::Phase currentPhase = AllocationCounter::OTHER;
+}
+
+void AllocationCounter::count()
+{
+    allocationCounts[currentPhase]++;
+}
+
+AllocationCounter::Phase AllocationCounter::getPhase()
+{
+    return currentPhase;
+}
+
+void AllocationCounter::setPhase(Phase phase)
+{
+    currentPhase = phase;
+}
+
+/*
+ * Replacements of the global allocation functions. They are used only in the counting build,
+ * because they affect every allocation made in the process. All the forms of the functions are
+ * replaced (the nothrow, sized and aligned ones too), so no allocation escapes counting and every
+ * block is released by the function matching the one which allocated it.
+ */
+void* operator new(size_t size)
+{
+    AllocationCounter::count();
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == NULL)
+        throw bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept
+{
+    AllocationCounter::count();
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, const nothrow_t&) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr, const nothrow_t&) noexcept
+{
+    free(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+#endif
+
+#ifdef __cpp_aligned_new
+namespace
+{
+/*
+ * Aligned blocks are cut from larger blocks of malloc; the pointer returned by malloc
+ * is stored just before the aligned block.
+ */
+void* allocateAligned(size_t size, size_t alignment)
+{
+    if (alignment < sizeof(void*))
+        alignment = sizeof(void*);
+    char* base = static_cast<char*>(malloc(size + alignment + sizeof(void*)));
+    if (base == NULL)
+        return NULL;
+    size_t address = reinterpret_cast<size_t>(base + sizeof(void*));
+    char* ptr = base + sizeof(void*) + (alignment - address % alignment) % alignment;
+    reinterpret_cast<void**>(ptr)[-1] = base;
+    return ptr;
+}
+
+void freeAligned(void* ptr)
+{
+    if (ptr != NULL)
+        free(static_cast<void**>(ptr)[-1]);
+}
+}
+
+void* operator new(size_t size, align_val_t alignment)
+{
+    AllocationCounter::count();
+    void* ptr = allocateAligned(size, static_cast<size_t>(alignment));
+    if (ptr == NULL)
+        throw bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size, align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept
+{
+    AllocationCounter::count();
+    return allocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t& tag) noexcept
+{
+    return operator new(size, alignment, tag);
+}
+
+void operator delete(void* ptr, align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, align_val_t, const nothrow_t&) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, align_val_t, const nothrow_t&) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, size_t, align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, size_t, align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+#endif
+#endif
+
+void AllocationCounter::reset()
+{
+#ifdef CRULES_COUNT_ALLOCATIONS
+    for (int i = 0; i < NUMBER_OF_PHASES; i++)
+        allocationCounts[i] = 0;
+#endif
+}
+
+/**
+ * Returns numbers of heap allocations in each phase since the last reset
+ * @return description of the numbers of allocations or empty string if counting is disabled
+ */
+string AllocationCounter::report()
+{
+#ifdef CRULES_COUNT_ALLOCATIONS
+    const char* names[NUMBER_OF_PHASES] = {"other", "grow", "prune", "covering", "stats", "predict"};
+    ostringstream oss;
+    oss << "heap allocations:";
+    for (int i = 0; i < NUMBER_OF_PHASES; i++)
+        oss << " " << names[i] << "=" << allocationCounts[i];
+    return oss.str();
+#else
+    return string();
+#endif
+}
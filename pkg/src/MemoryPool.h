@@ -0,0 +1,168 @@
+#ifndef MEMORYPOOL_H
+#define	MEMORYPOOL_H
+
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <new>
+#include "RulesInductionException.h"
+
+/**
+ * Pool of small memory blocks used for short-lived temporaries created during the induction
+ * (nodes of the containers used by the search for the best condition, lists of candidate conditions).
+ * Blocks are grouped in size classes; freed blocks are kept on per-class free lists and reused,
+ * so after the first rule the induction does almost no calls to the system allocator.
+ * Requests larger than the biggest size class are passed to the global operator new.
+ * One pool is owned by every induction object, so pools are never shared between threads.
+ */
+class MemoryPool
+{
+public:
+    MemoryPool();
+    ~MemoryPool();
+    void* allocate(std::size_t bytes);
+    void deallocate(void* ptr, std::size_t bytes);
+    void reset() throw (RulesInductionException);
+private:
+    MemoryPool(const MemoryPool&);
+    MemoryPool& operator=(const MemoryPool&);
+
+    struct FreeBlock { FreeBlock* next; };
+    static const std::size_t GRANULARITY = 16;
+    static const std::size_t SIZE_CLASSES = 16;    /**< blocks up to 256 bytes are pooled*/
+    static const std::size_t CHUNK_SIZE = 64 * 1024;
+
+    FreeBlock* freeLists[SIZE_CLASSES];
+    std::vector<char*> chunks;
+    std::size_t currentChunk;
+    char* chunkPtr;
+    char* chunkEnd;
+#ifdef CRULES_COUNT_ALLOCATIONS
+    std::size_t liveBlocks;     /**< blocks allocated and not deallocated yet (checked by reset)*/
+#endif
+};
+
+/**
+ * STL allocator which takes memory from MemoryPool object
+ */
+template <class T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    template <class U> struct rebind { typedef PoolAllocator<U> other; };
+
+    PoolAllocator(MemoryPool& pool) : pool(&pool) {}
+    template <class U> PoolAllocator(const PoolAllocator<U>& other) : pool(other.getPool()) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(pool->allocate(n * sizeof(T))); }
+    void deallocate(T* ptr, std::size_t n) { pool->deallocate(ptr, n * sizeof(T)); }
+    MemoryPool* getPool() const { return pool; }
+
+    template <class U> bool operator==(const PoolAllocator<U>& other) const { return pool == other.getPool(); }
+    template <class U> bool operator!=(const PoolAllocator<U>& other) const { return pool != other.getPool(); }
+private:
+    MemoryPool* pool;
+};
+
+/**
+ * Per-thread free list of fixed-size blocks for objects which are created and destroyed
+ * very often but outlive the induction (e.g. relational operators of elementary conditions
+ * which are cloned on every copy of a condition). At most MAX_FREE_BLOCKS blocks are kept.
+ */
+class FixedSizeAllocator
+{
+public:
+    static const std::size_t BLOCK_SIZE = 16;
+    static void* allocate(std::size_t bytes);
+    static void deallocate(void* ptr, std::size_t bytes);
+    static void clear();
+private:
+    static const std::size_t MAX_FREE_BLOCKS = 4096;
+};
+
+/**
+ * Per-thread cache of index buffers of SetOfExamples objects. Buffers of destroyed sets
+ * are kept with their capacity, so new sets filled with push_back rarely need reallocation.
+ * At most MAX_CACHED_BYTES bytes of buffers are kept by a thread.
+ */
+class IndexBufferPool
+{
+public:
+    static void acquire(std::vector<int>& buffer);
+    static void release(std::vector<int>& buffer);
+    static void clear();
+private:
+    static const std::size_t MAX_BUFFERS = 32;
+    static const std::size_t MAX_CACHED_BYTES = 4 * 1024 * 1024;
+};
+
+/**
+ * Frees the per-thread caches of FixedSizeAllocator and IndexBufferPool of the calling thread and
+ * of the threads of OpenMP when it is destroyed, so no memory is held between the calls from R.
+ * Created at the beginning of every entry point of RInterface.
+ */
+class ThreadCachesScope
+{
+public:
+    ThreadCachesScope() {}
+    ~ThreadCachesScope() { release(); }
+    static void release();
+private:
+    ThreadCachesScope(const ThreadCachesScope&);
+    ThreadCachesScope& operator=(const ThreadCachesScope&);
+};
+
+/**
+ * Counts calls to the global allocator in phases of the induction.
+ * Works only when the package is compiled with CRULES_COUNT_ALLOCATIONS defined, e.g. by
+ * adding "PKG_CPPFLAGS=-DCRULES_COUNT_ALLOCATIONS" to ~/.R/Makevars before installing the package
+ * (profiling only; the counts are printed after each call to generateRules, predict and crossValidation).
+ * The same build checks that no block of a MemoryPool is alive when the pool is reset.
+ * Otherwise AllocationPhase is an empty object and the report is empty.
+ */
+class AllocationCounter
+{
+public:
+    enum Phase
+    {
+        OTHER,      /**< allocations outside of the phases listed below*/
+        GROW,       /**< growth of rules*/
+        PRUNE,      /**< pruning of rules*/
+        COVERING,   /**< computing covered and uncovered examples between rules*/
+        STATS,      /**< computing rule statistics*/
+        PREDICT,    /**< classification*/
+        NUMBER_OF_PHASES
+    };
+    static void reset();
+    static std::string report();
+#ifdef CRULES_COUNT_ALLOCATIONS
+    static void count();
+    static Phase getPhase();
+    static void setPhase(Phase phase);
+#endif
+};
+
+/**
+ * Marks the scope as a phase for AllocationCounter. Restores the previous phase when destroyed.
+ */
+class AllocationPhase
+{
+public:
+#ifdef CRULES_COUNT_ALLOCATIONS
+    AllocationPhase(AllocationCounter::Phase phase) : previous(AllocationCounter::getPhase()) { AllocationCounter::setPhase(phase); }
+    ~AllocationPhase() { AllocationCounter::setPhase(previous); }
+private:
+    AllocationCounter::Phase previous;
+#else
+    AllocationPhase(AllocationCounter::Phase) {}
+#endif
+};
+
+#endif	/* MEMORYPOOL_H */
@@ -0,0 +1,64 @@
+#ifndef NOKNOWLEDGEPOLICY_H
+#define	NOKNOWLEDGEPOLICY_H
+
+#include "ElementaryCondition.h"
+#include "SetOfExamples.h"
+#include "Rule.h"
+#include "KnowledgeRule.h"
+#include "KnowledgeCondition.h"
+#include <list>
+#include <vector>
+
+/**
+ * Knowledge policy of the covering without any knowledge: every class is induced, every condition
+ * is allowed and none is required. The checks are constants, so CoveringEngine<NoKnowledgePolicy>
+ * compiles to the plain sequential covering. Defines the interface of knowledge policies.
+ */
+class NoKnowledgePolicy
+{
+public:
+    /** true if thresholds of specified conditions are added to the values of numerical attributes*/
+    static const bool hasKnowledge = false;
+
+    /** called before the induction on the training set*/
+    void prepare(SetOfExamples&) {}
+    /** @return true if no rules are induced for the class*/
+    bool isClassSkipped(double) const { return false; }
+    /** @return true if the induction of rules for the class starts from the specified conditions only*/
+    bool isSpecifiedOnly(double) const { return false; }
+    /** @return true if only the specified conditions may ever be used*/
+    bool isUseSpecifiedOnly() const { return false; }
+    /** @return true if other conditions may be used when the specified ones do not give a rule*/
+    bool isExpandable(double) const { return false; }
+    /** @return number of rules from the specified conditions accepted even if their precision is too low*/
+    int getRulesAtLeast(double) const { return 0; }
+    /** @return false if only the allowed rules are used for the class*/
+    bool isCoveringAllowed(double) const { return true; }
+    /** @return rules given for the class*/
+    std::list<KnowledgeRule>& getAllowedRules(double)
+    {
+        static std::list<KnowledgeRule> noRules;
+        return noRules;
+    }
+    /** conditions of the rule are allowed while the rule is expanded*/
+    void allowRuleConditions(double, KnowledgeRule&) {}
+    void disallowRuleConditions(double, KnowledgeRule&) {}
+
+    /** adds thresholds of the specified conditions to the values of the attribute (with negative indices)*/
+    template <class Values>
+    void addThresholds(double, int, Values&) const {}
+    /** @return allowed nominal conditions of the class on the attribute*/
+    const std::vector<KnowledgeCondition>& getAllowedConditions(double, int) const
+    {
+        static const std::vector<KnowledgeCondition> noConditions;
+        return noConditions;
+    }
+    /** @return true if the condition "attribute >= value" (or "<") may be added to the rule*/
+    bool isNumericConditionAllowed(Rule&, double, int, double, bool, bool) { return true; }
+    /** @return true if the condition "attribute = value" may be added to the rule*/
+    bool isNominalConditionAllowed(Rule&, double, int, double) { return true; }
+    /** @return true if the condition cannot be removed from the rule by pruning*/
+    bool isConditionRequired(ElementaryCondition&, Rule&, Attribute::AttributeType) { return false; }
+};
+
+#endif	/* NOKNOWLEDGEPOLICY_H */
@@ -1,6 +1,7 @@
 #ifndef OPERATOR_H
 #define	OPERATOR_H
 #include "Attribute.h"
+#include "MemoryPool.h"
 #include <string>
 
 /*
@@ -18,6 +19,9 @@ public:
     virtual bool operator()(double, double) = 0;
     virtual std::string toString() const = 0;
     virtual RelationalOperator* clone() = 0;
+    //operators are cloned on every copy of an elementary condition, so they are kept in a per-thread pool
+    static void* operator new(std::size_t size) { return FixedSizeAllocator::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { FixedSizeAllocator::deallocate(ptr, size); }
 };
 
 /**
@@ -0,0 +1,284 @@
+#include "OptimisticBound.h"
+
+using namespace std;
+
+/**
+ * Remembers the covered examples, so the summaries of all the attributes read only their columns
+ * @param covered set of examples covered by current rule
+ * @param decClass positive class
+ */
+void OptimisticBound::setExamples(SetOfExamples& covered, double decClass)
+{
+    int size = covered.size();
+    rows.resize(size);
+    weights.resize(size);
+    positives.resize(size);
+    for (int j = 0; j < size; j++)
+    {
+        rows[j] = covered.getIndex(j);
+        weights[j] = covered.getWeight(j);
+        positives[j] = covered[j].getDecisionAttribute() == decClass;
+    }
+}
+
+/**
+ * Summarizes a dense numerical attribute (see the column version)
+ * @param columns columns of the data set
+ * @param attributeIndex index of the attribute
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ */
+void OptimisticBound::summarizeNumericalAttribute(const ColumnStore& columns, int attributeIndex, double P, double N)
+{
+    switch (columns.getType(attributeIndex))
+    {
+        case ColumnStore::FLOAT_COLUMN:
+            summarizeNumericalAttribute(columns.getColumn<float>(attributeIndex), P, N);
+            break;
+        case ColumnStore::INT_COLUMN:
+            summarizeNumericalAttribute(columns.getColumn<int>(attributeIndex), P, N);
+            break;
+        case ColumnStore::SHORT_COLUMN:
+            summarizeNumericalAttribute(columns.getColumn<unsigned short>(attributeIndex), P, N);
+            break;
+        case ColumnStore::BYTE_COLUMN:
+            summarizeNumericalAttribute(columns.getColumn<unsigned char>(attributeIndex), P, N);
+            break;
+        default:
+            summarizeNumericalAttribute(columns.getColumn<double>(attributeIndex), P, N);
+    }
+}
+
+/**
+ * Summarizes a numerical attribute by the results of the purest conditions "attribute >= value"
+ * and "attribute < value" and of the widest conditions covering negative examples
+ * @param column values of the attribute of the type of the column
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ */
+template <class T>
+void OptimisticBound::summarizeNumericalAttribute(const T* column, double P, double N)
+{
+    int size = rows.size();
+    double p = 0;
+    maxNegative = -numeric_limits<double>::infinity();
+    minNegative = numeric_limits<double>::infinity();
+    maxNegativeWeight = minNegativeWeight = 0;
+    for (int j = 0; j < size; j++)
+    {
+        double attValue = ColumnStore::toDouble(column[rows[j]]);
+        if (attValue != attValue)
+            continue;
+        if (positives[j])
+            p += weights[j];
+        else
+            addNegative(attValue, weights[j]);
+    }
+
+    pAbove = pBelow = 0;
+    if (p > 0 && maxNegativeWeight != 0)
+        for (int j = 0; j < size; j++)
+        {
+            if (!positives[j])
+                continue;
+            double attValue = ColumnStore::toDouble(column[rows[j]]);
+            if (attValue > maxNegative)
+                pAbove += weights[j];
+            else if (attValue < minNegative)
+                pBelow += weights[j];
+        }
+    summarizeNegatives(p, P, N);
+}
+
+/**
+ * Summarizes a sparse numerical attribute like summarizeNumericalAttribute; the covered examples
+ * with the default value are taken as two groups (positive and negative) of examples with that value
+ * @param column values of the attribute
+ * @param coveredRows covered examples by their rows
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ */
+void OptimisticBound::summarizeSparseNumericalAttribute(const SparseColumn& column, const CoveredRows& coveredRows, double P, double N)
+{
+    const vector<double>& values = column.getValues();
+    double defaultValue = column.getDefaultValue();
+    coveredRows.findStoredValues(column, found);
+
+    double p = 0, storedPositive = 0, storedNegative = 0;
+    int storedPositives = 0;
+    maxNegative = -numeric_limits<double>::infinity();
+    minNegative = numeric_limits<double>::infinity();
+    maxNegativeWeight = minNegativeWeight = 0;
+    for (vector<pair<int, int> >::const_iterator it = found.begin(); it != found.end(); it++)
+    {
+        int j = it->first;
+        double attValue = values[it->second];
+        if (positives[j])
+        {
+            storedPositive += weights[j];
+            storedPositives++;
+        }
+        else
+            storedNegative += weights[j];
+        if (attValue != attValue)
+            continue;
+        if (positives[j])
+            p += weights[j];
+        else
+            addNegative(attValue, weights[j]);
+    }
+
+    //covered examples with the default value
+    bool defaultKnown = defaultValue == defaultValue;
+    int defaultPositives = coveredRows.getNumberOfPositives() - storedPositives;
+    int defaultNegatives = coveredRows.getNumberOfExamples() - coveredRows.getNumberOfPositives() - (found.size() - storedPositives);
+    double defaultPositive = defaultPositives > 0 ? max(coveredRows.getPositiveWeight() - storedPositive, 0.0) : 0;
+    if (defaultKnown && defaultPositives > 0)
+        p += defaultPositive;
+    if (defaultKnown && defaultNegatives > 0)
+        addNegative(defaultValue, max(coveredRows.getNegativeWeight() - storedNegative, 0.0));
+
+    pAbove = pBelow = 0;
+    if (p > 0 && maxNegativeWeight != 0)
+    {
+        for (vector<pair<int, int> >::const_iterator it = found.begin(); it != found.end(); it++)
+        {
+            if (!positives[it->first])
+                continue;
+            double attValue = values[it->second];
+            if (attValue > maxNegative)
+                pAbove += weights[it->first];
+            else if (attValue < minNegative)
+                pBelow += weights[it->first];
+        }
+        if (defaultKnown && defaultPositives > 0)
+        {
+            if (defaultValue > maxNegative)
+                pAbove += defaultPositive;
+            else if (defaultValue < minNegative)
+                pBelow += defaultPositive;
+        }
+    }
+    summarizeNegatives(p, P, N);
+}
+
+/**
+ * Updates the greatest and the least values of the negative examples with their weights
+ * @param value value of the attribute of negative examples
+ * @param weight weight of the examples
+ */
+void OptimisticBound::addNegative(double value, double weight)
+{
+    if (value > maxNegative)
+    {
+        maxNegative = value;
+        maxNegativeWeight = 0;
+    }
+    if (value == maxNegative)
+        maxNegativeWeight += weight;
+    if (value < minNegative)
+    {
+        minNegative = value;
+        minNegativeWeight = 0;
+    }
+    if (value == minNegative)
+        minNegativeWeight += weight;
+}
+
+/**
+ * Creates the results bounding the conditions of a numerical attribute
+ * @param p weight of the covered positive examples with known values
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ */
+void OptimisticBound::summarizeNegatives(double p, double P, double N)
+{
+    results.clear();
+    if (p == 0)
+        return;
+    if (maxNegativeWeight == 0)
+    {
+        results.push_back(RuleEvaluationResult(P, p, N, 0));
+        return;
+    }
+    if (pAbove > 0)
+        results.push_back(RuleEvaluationResult(P, pAbove, N, 0));
+    if (pBelow > 0)
+        results.push_back(RuleEvaluationResult(P, pBelow, N, 0));
+    results.push_back(RuleEvaluationResult(P, p, N, maxNegativeWeight));
+    results.push_back(RuleEvaluationResult(P, p, N, minNegativeWeight));
+}
+
+/**
+ * Summarizes a nominal attribute (see the column version)
+ * @param columns columns of the data set
+ * @param attributeIndex index of the attribute
+ * @param numberOfLevels number of levels of the attribute
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ */
+void OptimisticBound::summarizeNominalAttribute(const ColumnStore& columns, int attributeIndex, size_t numberOfLevels, double P, double N)
+{
+    switch (columns.getType(attributeIndex))
+    {
+        case ColumnStore::BYTE_COLUMN:
+            summarizeNominalAttribute(columns.getColumn<unsigned char>(attributeIndex), numberOfLevels, P, N);
+            break;
+        case ColumnStore::SHORT_COLUMN:
+            summarizeNominalAttribute(columns.getColumn<unsigned short>(attributeIndex), numberOfLevels, P, N);
+            break;
+        case ColumnStore::INT_COLUMN:
+            summarizeNominalAttribute(columns.getColumn<int>(attributeIndex), numberOfLevels, P, N);
+            break;
+        default:
+            summarizeNominalAttribute(columns.getColumn<double>(attributeIndex), numberOfLevels, P, N);
+    }
+}
+
+/**
+ * Summarizes a nominal attribute by the results of conditions "attribute = level" covering positive examples.
+ * Levels are indices of the values of the attribute; if they are not, the attribute is summarized by
+ * all the covered examples with known values.
+ * @param column values of the attribute of the type of the column
+ * @param numberOfLevels number of levels of the attribute
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ */
+template <class T>
+void OptimisticBound::summarizeNominalAttribute(const T* column, size_t numberOfLevels, double P, double N)
+{
+    int size = rows.size();
+    double p = 0;
+    bool indices = true;
+    levels.assign(numberOfLevels, RuleEvaluationResult());
+    for (int j = 0; j < size; j++)
+    {
+        double attValue = ColumnStore::toDouble(column[rows[j]]);
+        if (attValue != attValue)
+            continue;
+        if (positives[j])
+            p += weights[j];
+        if (!indices)
+            continue;
+        if (attValue < 0 || attValue >= numberOfLevels || attValue != (size_t)attValue)
+        {
+            indices = false;
+            continue;
+        }
+        if (positives[j])
+            levels[(size_t)attValue].p += weights[j];
+        else
+            levels[(size_t)attValue].n += weights[j];
+    }
+
+    results.clear();
+    if (!indices)
+    {
+        if (p > 0)
+            results.push_back(RuleEvaluationResult(P, p, N, 0));
+        return;
+    }
+    for (size_t level = 0; level < numberOfLevels; level++)
+        if (levels[level].p > 0)
+            results.push_back(RuleEvaluationResult(P, levels[level].p, N, levels[level].n));
+}
@@ -0,0 +1,101 @@
+#ifndef OPTIMISTICBOUND_H
+#define	OPTIMISTICBOUND_H
+
+#include "RuleEvaluationResult.h"
+#include "RuleQualityMeasure.h"
+#include "SetOfExamples.h"
+#include "CoveredRows.h"
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * Optimistic estimate of the quality of the conditions on one attribute, computed in one pass over
+ * the covered examples (without sorting them). The attribute is summarized by a few evaluation results
+ * such that every condition on the attribute covers at most as many positive and at least as many
+ * negative examples as one of them, so for a measure with optimistic bounds no condition on
+ * the attribute is better than the best of the bounds of the results:
+ *  - numerical attributes: a condition "attribute >= value" either covers no negative examples and
+ *    only the positives above the greatest value of a negative example, or it covers all the negatives
+ *    with that greatest value (similarly for "attribute < value" and the least value),
+ *  - nominal attributes: the result of every level of the attribute.
+ * Sparse numerical attributes are summarized from their stored values and one group of the covered
+ * examples with the default value.
+ */
+class OptimisticBound
+{
+public:
+    void setExamples(SetOfExamples& covered, double decClass);
+    template <class Measure>
+    double evaluate(Measure& rqm, SetOfExamples& covered, int attributeIndex, double P, double N, const CoveredRows& coveredRows);
+    static bool isBelow(double bound, double quality);
+private:
+    void summarizeNumericalAttribute(const ColumnStore& columns, int attributeIndex, double P, double N);
+    template <class T>
+    void summarizeNumericalAttribute(const T* column, double P, double N);
+    void summarizeSparseNumericalAttribute(const SparseColumn& column, const CoveredRows& coveredRows, double P, double N);
+    void addNegative(double value, double weight);
+    void summarizeNegatives(double p, double P, double N);
+    void summarizeNominalAttribute(const ColumnStore& columns, int attributeIndex, std::size_t numberOfLevels, double P, double N);
+    template <class T>
+    void summarizeNominalAttribute(const T* column, std::size_t numberOfLevels, double P, double N);
+
+    std::vector<int> rows;                      /**< indices of the covered examples in the data set*/
+    std::vector<double> weights;                /**< weights of the covered examples*/
+    std::vector<char> positives;                /**< true for the covered positive examples*/
+    std::vector<RuleEvaluationResult> results;  /**< results bounding the conditions on the attribute*/
+    std::vector<RuleEvaluationResult> levels;   /**< counts of examples for every level of a nominal attribute*/
+    std::vector<std::pair<int, int> > found;    /**< covered examples among the stored values of a sparse column*/
+    double maxNegative, minNegative;            /**< greatest and least values of the negative examples*/
+    double maxNegativeWeight, minNegativeWeight;
+    double pAbove, pBelow;                      /**< weights of the positives above and below the values of all negatives*/
+};
+
+/**
+ * Computes the optimistic bound of the quality of conditions on the attribute
+ * @param rqm rule quality measure (with optimistic bounds)
+ * @param covered set of examples covered by current rule (the same as given to setExamples)
+ * @param attributeIndex index of the attribute
+ * @param P number of all positive examples
+ * @param N number of all negative examples
+ * @param coveredRows covered examples by their rows (set if the data set has sparse columns)
+ * @return the bound, NaN if it is not known and -infinity if no condition can be built on the attribute
+ */
+template <class Measure>
+double OptimisticBound::evaluate(Measure& rqm, SetOfExamples& covered, int attributeIndex, double P, double N, const CoveredRows& coveredRows)
+{
+    const ColumnStore& columns = covered.getDataSet().getColumns();
+    if (columns.isSparse(attributeIndex))
+        summarizeSparseNumericalAttribute(columns.getSparseColumn(attributeIndex), coveredRows, P, N);
+    else if (covered.getAttributeType(attributeIndex) == Attribute::NUMERICAL)
+        summarizeNumericalAttribute(columns, attributeIndex, P, N);
+    else
+        summarizeNominalAttribute(columns, attributeIndex, covered.getDataSet().getConditionalAttribute(attributeIndex).getLevels().size(), P, N);
+
+    double bound = -std::numeric_limits<double>::infinity();
+    for (std::vector<RuleEvaluationResult>::const_iterator it = results.begin(); it != results.end(); it++)
+    {
+        double quality = rqm.EvaluateOptimisticBound(*it);
+        if (quality != quality)
+            return quality;
+        if (quality > bound)
+            bound = quality;
+    }
+    return bound;
+}
+
+/**
+ * Checks if conditions with the given bound cannot be as good as the best condition found so far.
+ * Bounds and qualities of the conditions are computed from weights summed in different orders,
+ * so the bound has to be lower by more than the rounding error.
+ * @param bound optimistic bound (NaN if not known)
+ * @param quality quality of the best condition
+ * @return true if the conditions may be skipped
+ */
+inline bool OptimisticBound::isBelow(double bound, double quality)
+{
+    return bound < quality - 1e-9 * (std::fabs(quality) + 1);
+}
+
+#endif	/* OPTIMISTICBOUND_H */
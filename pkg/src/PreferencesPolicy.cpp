@@ -0,0 +1,273 @@
+#include "PreferencesPolicy.h"
+#include <typeinfo>
+
+using namespace std;
+
+/**
+ * Compiles the knowledge for the training set
+ * @param examples training set on which the induction is based
+ */
+void PreferencesPolicy::prepare(SetOfExamples& examples)
+{
+    dataSet = &examples.getDataSet();
+    index.build(*knowledge, *dataSet);
+}
+
+/**
+ * Rules of a class without any knowledge are not induced unless rules for other classes are requested
+ * @param decClass decision class
+ * @return true if no rules are induced for the class
+ */
+bool PreferencesPolicy::isClassSkipped(double decClass)
+{
+    return !knowledge->isGenerateRulesForOtherClasses() && knowledge->getAllowedRules()[decClass].size() == 0
+            && knowledge->getAllowedConditions()[decClass].getConditions().size() == 0
+            && knowledge->getForbiddenRules()[decClass].size() == 0 && knowledge->getForbiddenConditions()[decClass].getConditions().size() == 0;
+}
+
+/**
+ * Temporarily adds conditions of the allowed rule to the allowed conditions of the class,
+ * so their "fixed" and "required" properties are respected while the rule is expanded
+ * @param decClass decision class
+ * @param rule allowed rule
+ */
+void PreferencesPolicy::allowRuleConditions(double decClass, KnowledgeRule& rule)
+{
+    list<KnowledgeCondition>& allowed = knowledge->getAllowedConditions()[decClass].getConditions();
+    allowed.insert(allowed.end(), rule.getConditions().getConditions().begin(), rule.getConditions().getConditions().end());
+    index.update(*knowledge, *dataSet, decClass);
+}
+
+/**
+ * Removes conditions added by allowRuleConditions
+ * @param decClass decision class
+ * @param rule allowed rule
+ */
+void PreferencesPolicy::disallowRuleConditions(double decClass, KnowledgeRule& rule)
+{
+    list<KnowledgeCondition>& allowed = knowledge->getAllowedConditions()[decClass].getConditions();
+    list<KnowledgeCondition>::iterator remBegin = allowed.end();
+    for(unsigned int i = 0; i < rule.getConditions().getConditions().size(); i++) remBegin--;
+    allowed.erase(remBegin, allowed.end());
+    index.update(*knowledge, *dataSet, decClass);
+}
+
+/**
+ * Checks if a numerical condition may be added to the rule: it is specified (if only specified conditions
+ * are used) and it is not forbidden, alone or together with the conditions of the rule
+ * @param rule rule being grown
+ * @param decClass decision class
+ * @param attributeIndex index of the attribute
+ * @param value threshold of the condition
+ * @param greaterEqual true for a condition "attribute >= value", false for "attribute < value"
+ * @param useSpecifiedOnly true if only specified conditions are used
+ * @return true if the condition is allowed
+ */
+bool PreferencesPolicy::isNumericConditionAllowed(Rule& rule, double decClass, int attributeIndex, double value, bool greaterEqual, bool useSpecifiedOnly)
+{
+    if(useSpecifiedOnly && !index.isNumericConditionSpecified(decClass, attributeIndex, value, greaterEqual))
+        return false;
+    return !isNumericConditionForbidden(rule, decClass, attributeIndex, value, greaterEqual);
+}
+
+/**
+ * Checks if the condition is required, so it cannot be removed from the rule by pruning
+ * @param condition condition of the rule
+ * @param rule rule being pruned
+ * @param attributeType type of the attribute of the condition
+ * @return true if the condition is required
+ */
+bool PreferencesPolicy::isConditionRequired(ElementaryCondition& condition, Rule& rule, Attribute::AttributeType attributeType)
+{
+    switch (attributeType)
+    {
+        case Attribute::NUMERICAL:
+            return isNumericConditionRequired(condition, rule);
+        case Attribute::NOMINAL:
+            return isNominalConditionRequired(condition, rule);
+    }
+    return false;
+}
+
+bool PreferencesPolicy::isNumericConditionForbidden(Rule& rule, double decClass, int attributeIndex, double value, bool greaterEqual)
+{
+	bool isForbidden = index.isNumericConditionForbidden(decClass, attributeIndex, value, greaterEqual);
+
+	if(!isForbidden)
+		isForbidden = isConditionForbiddenInRule(rule, decClass, attributeIndex, value, greaterEqual, false);
+
+	return isForbidden;
+}
+
+bool PreferencesPolicy::isConitionsInterceptionNotEmpty(double /*decClass*/, int /*attributeIndex*/, double value, bool greaterEqual, KnowledgeCondition& cond)
+{
+	bool result = false;
+	if(cond.isFixed())
+	{
+		if((greaterEqual && value == cond.getFrom()) || (!greaterEqual && value == cond.getTo()))
+		{
+			result = true;
+		}
+	}
+	else
+	{
+		if((greaterEqual && value < cond.getTo()) || (!greaterEqual && value > cond.getFrom()))
+		{
+			result = true;
+		}
+	}
+	return result;
+}
+
+bool PreferencesPolicy::isNominalConditionForbidden(Rule& rule, double decClass, int attributeIndex, double value)
+{
+	bool isForbidden = index.isNominalConditionForbidden(decClass, attributeIndex, value);
+
+	if(!isForbidden)
+		isForbidden = isConditionForbiddenInRule(rule, decClass, attributeIndex, value, false, true);
+
+	return isForbidden;
+}
+
+bool PreferencesPolicy::isNominalConditionRequired(ElementaryCondition& condition, Rule& rule)
+{
+	double decClass = rule.getDecisionClass();
+	int attributeIndex = condition.getAttributeIndex();
+	double value = condition.getAttributeValue();
+
+	bool result = false;
+
+	if(index.isNominalConditionSpecified(decClass, attributeIndex, value, true))
+	{
+		int numberOfRequired = 0;
+
+		if(rule.getConditions()[attributeIndex].size() > 1)
+		{
+			for(list<ElementaryCondition>::iterator it = rule.getConditions()[attributeIndex].begin(); it != rule.getConditions()[attributeIndex].end(); it++)
+				if(index.isNominalConditionSpecified(decClass, attributeIndex, it->getAttributeValue(), true))	//is specified and required
+					numberOfRequired++;
+		}
+
+		if(numberOfRequired < 2)
+		{
+			result = true;
+		}
+	}
+
+	return result;
+}
+
+bool PreferencesPolicy::isNumericConditionRequired(ElementaryCondition& condition, Rule& rule)
+{
+	double decClass = rule.getDecisionClass();
+	int attributeIndex = condition.getAttributeIndex();
+	double value = condition.getAttributeValue();
+
+	bool result = false;
+	bool greaterEqual = typeid(*condition.getOperator()) == typeid(GreaterEqualOperator);
+
+	if(index.isNumericConditionSpecified(decClass, attributeIndex, value, greaterEqual, true))
+	{
+		result = true;
+		//checking if other required condition with the same "direction" exists for this attribute; if yes, the main condition can be removed
+		if(rule.getConditions()[attributeIndex].size() > 1)
+		{
+			for(list<ElementaryCondition>::iterator it = rule.getConditions()[attributeIndex].begin(); it != rule.getConditions()[attributeIndex].end(); it++)
+				if(*it != condition && 	//not the same condition
+					(typeid(*it->getOperator()) == typeid(*condition.getOperator())) && //the same operator
+					index.isNumericConditionSpecified(decClass, attributeIndex, it->getAttributeValue(), greaterEqual, true))	//is specified and required
+				{
+					result = false;
+					break;
+				}
+		}
+	}
+
+	return result;
+}
+
+bool PreferencesPolicy::isConditionForbiddenInRule(Rule& rule, double decClass, int attributeIndex, double value, bool greaterEqual, bool nominal)
+{
+	bool isForbidden = false;
+
+	//for each forbidden rule with a condition on the attribute
+	const vector<KnowledgeRule*>& forbiddenRules = index.getForbiddenRules(decClass, attributeIndex);
+	for(vector<KnowledgeRule*>::const_iterator it = forbiddenRules.begin(); !isForbidden && it != forbiddenRules.end(); it++)
+	{
+		KnowledgeRule* itForbRule = *it;
+		//check if current condition is present in forbidden rule
+		list<KnowledgeCondition>::iterator itForbCond;
+		for(itForbCond = itForbRule->getConditions().getConditions().begin(); itForbCond != itForbRule->getConditions().getConditions().end(); itForbCond++)
+		{
+			if(itForbCond->getAttributeIndex() == attributeIndex)
+			{
+				if(nominal)
+				{
+					if(itForbCond->getValue() == value)
+						break;
+				}
+				else
+				{
+					if(isConitionsInterceptionNotEmpty(decClass, attributeIndex, value, greaterEqual, *itForbCond))
+						break;
+				}
+			}
+		}
+		//if current condition is present in "itForbRule" forbidden rule, check if all other conditions from this forbidden rule are in a current rule
+		if(itForbCond != itForbRule->getConditions().getConditions().end())
+		{
+			list<KnowledgeCondition>::iterator itForbCondPrime;
+			for(itForbCondPrime = itForbRule->getConditions().getConditions().begin(); itForbCondPrime != itForbRule->getConditions().getConditions().end(); itForbCondPrime++)
+			{
+				if(itForbCondPrime == itForbCond)
+					continue;
+
+				//check if "itCondPrime" condition from forbidden rule is present in current rule
+				bool isConditionPresent = false;
+
+				if(rule.getConditions().size() > (unsigned int)itForbCondPrime->getAttributeIndex())
+				{
+					if(itForbCondPrime->getAttributeType() == Attribute::NOMINAL)
+					{
+						if(rule.getConditions()[attributeIndex].size() == 0 && itForbRule->getConditions().getConditionsForAttribute(attributeIndex).size() > 1)
+						{
+							isConditionPresent = true;
+						}
+						else
+						{
+							for(list<ElementaryCondition>::iterator itElCond = rule.getConditions()[itForbCondPrime->getAttributeIndex()].begin(); itElCond != rule.getConditions()[itForbCondPrime->getAttributeIndex()].end(); itElCond++)
+							{
+								if(itForbCondPrime->getValue() == itElCond->getAttributeValue() ||
+										itForbRule->getConditions().getConditionsForAttribute(itForbCondPrime->getAttributeIndex()).size() > 1)
+								{
+									isConditionPresent = true;
+									break;
+								}
+							}
+						}
+					}
+					else
+					{
+						for(list<ElementaryCondition>::iterator itElCond = rule.getConditions()[itForbCondPrime->getAttributeIndex()].begin(); itElCond != rule.getConditions()[itForbCondPrime->getAttributeIndex()].end(); itElCond++)
+						{
+							if(isConitionsInterceptionNotEmpty(decClass, itElCond->getAttributeIndex(), itElCond->getAttributeValue(), typeid(*itElCond->getOperator()) == typeid(GreaterEqualOperator), *itForbCondPrime))
+							{
+								isConditionPresent = true;
+								break;
+							}
+						}
+					}
+				}
+
+				//if not, adding condition to the rule will not create forbidden conjunction according to "itRule"
+				if(!isConditionPresent)
+					break;
+			}
+
+			if(itForbCondPrime == itForbRule->getConditions().getConditions().end())
+				isForbidden = true;
+		}
+	}
+
+	return isForbidden;
+}
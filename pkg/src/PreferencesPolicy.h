@@ -0,0 +1,83 @@
+#ifndef PREFERENCESPOLICY_H
+#define	PREFERENCESPOLICY_H
+
+#include "ElementaryCondition.h"
+#include "SetOfExamples.h"
+#include "Rule.h"
+#include "Operator.h"
+#include "Knowledge.h"
+#include "KnowledgeIndex.h"
+#include <list>
+#include <vector>
+#include <utility>
+
+/**
+ * Knowledge policy of the induction with preferences (see NoKnowledgePolicy for the interface).
+ * Rules are induced from the allowed rules and conditions first; forbidden conditions and rules
+ * are never created and required conditions are not pruned. The knowledge is not owned by the policy.
+ */
+class PreferencesPolicy
+{
+public:
+    static const bool hasKnowledge = true;
+
+    explicit PreferencesPolicy(Knowledge* knowledge = NULL) : knowledge(knowledge), dataSet(NULL) {}
+    Knowledge* getKnowledge() const { return knowledge; }
+
+    void prepare(SetOfExamples& examples);
+    bool isClassSkipped(double decClass);
+    bool isSpecifiedOnly(double decClass) { return knowledge->getAllowedConditions()[decClass].getConditions().size() > 0; }
+    bool isUseSpecifiedOnly() const { return knowledge->isUseSpecifiedOnly(); }
+    bool isExpandable(double decClass) { return knowledge->getAllowedConditions()[decClass].isExpandable(); }
+    int getRulesAtLeast(double decClass) { return knowledge->getAllowedConditions()[decClass].getRulesAtLeast(); }
+    bool isCoveringAllowed(double decClass) { return knowledge->getAllowedRules()[decClass].size() == 0 || !knowledge->isUseSpecifiedOnly(); }
+    std::list<KnowledgeRule>& getAllowedRules(double decClass) { return knowledge->getAllowedRules()[decClass]; }
+    void allowRuleConditions(double decClass, KnowledgeRule& rule);
+    void disallowRuleConditions(double decClass, KnowledgeRule& rule);
+
+    template <class Values>
+    void addThresholds(double decClass, int attributeIndex, Values& values) const;
+    const std::vector<KnowledgeCondition>& getAllowedConditions(double decClass, int attributeIndex) const
+    {
+        return index.getAllowedConditions(decClass, attributeIndex);
+    }
+    bool isNumericConditionAllowed(Rule& rule, double decClass, int attributeIndex, double value, bool greaterEqual, bool useSpecifiedOnly);
+    bool isNominalConditionAllowed(Rule& rule, double decClass, int attributeIndex, double value)
+    {
+        return !isNominalConditionForbidden(rule, decClass, attributeIndex, value);
+    }
+    bool isConditionRequired(ElementaryCondition& condition, Rule& rule, Attribute::AttributeType attributeType);
+private:
+    bool isNominalConditionForbidden(Rule& rule, double decClass, int attributeIndex, double value);
+    bool isNominalConditionRequired(ElementaryCondition& condition, Rule& rule);
+    bool isNumericConditionForbidden(Rule& rule, double decClass, int attributeIndex, double value, bool greaterEqual);
+    bool isNumericConditionRequired(ElementaryCondition& condition, Rule& rule);
+    bool isConitionsInterceptionNotEmpty(double decClass, int attributeIndex, double value, bool greaterEqual, KnowledgeCondition& cond);
+    bool isConditionForbiddenInRule(Rule& rule, double decClass, int attributeIndex, double value, bool greaterEqual, bool nominal);
+
+    Knowledge* knowledge;
+    DataSet* dataSet;     /**< data set of the induction*/
+    KnowledgeIndex index; /**< knowledge grouped by class and attribute; built before the induction*/
+};
+
+/**
+ * Adds the bounds of the allowed conditions on the attribute to the values of the attribute,
+ * so they are candidate thresholds even if no example has them
+ * @param decClass decision class
+ * @param attributeIndex index of the attribute
+ * @param values values of the attribute with indices of the examples; the bounds get indices -1, -2, ...
+ */
+template <class Values>
+void PreferencesPolicy::addThresholds(double decClass, int attributeIndex, Values& values) const
+{
+    const std::vector<KnowledgeCondition>& kConditions = index.getAllowedConditions(decClass, attributeIndex);
+    int kCondIndex = -1;
+    for(std::vector<KnowledgeCondition>::const_iterator it = kConditions.begin(); it != kConditions.end(); it++)
+    {
+        values.insert(std::pair<double, int>(it->getFrom(), kCondIndex));
+        values.insert(std::pair<double, int>(it->getTo(), kCondIndex));
+        kCondIndex--;
+    }
+}
+
+#endif	/* PREFERENCESPOLICY_H */
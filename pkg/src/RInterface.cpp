@@ -13,13 +13,16 @@ using namespace std;
  * @param xlevels 2-dim table of unique values of conditional attributes
  * @param rqmPrune name of rule quality measure to be used in pruning phase
  * @param rqmGrow  name of rule quality measure to be used in growing phase
+ * @param rules, confidenceDegrees, model rules of a previous model the covering starts from (may be absent)
  * @return representation of generated rules and their statistics
  */
 Rcpp::List RInterface::generateRules(Rcpp::List params)
 {
+    ThreadCachesScope caches;
     try
     {
-    	srand ( Rcpp::as<double>(params["seed"]) *  numeric_limits<unsigned int>::max());
+    	InductionContext context(createInductionContext(params));
+    	AllocationCounter::reset();
         //creating data set
         DataSet* ds = createDataSet(params);
         Knowledge* know = createKnowledgeObject(params, ds);
@@ -32,17 +35,32 @@ Rcpp::List RInterface::generateRules(Rcpp::List params)
         list<Rule> rules;
         if(know == NULL)
         {
-        	SequentialCovering sc;
-        	rules = sc.generateRules(examples, *rqmGrowPtr, *rqmPrunePtr);
+        	SequentialCovering sc(context);
+        	if(params.containsElementNamed("rules"))
+        	{
+        		RuleClassifier initialRules(loadRules(params, *ds));
+        		rules = sc.generateRules(examples, *rqmGrowPtr, *rqmPrunePtr, initialRules.getRules());
+        	}
+        	else
+        		rules = sc.generateRules(examples, *rqmGrowPtr, *rqmPrunePtr);
         }
         else
         {
-        	SequentialCoveringWithPreferences scwp(know);
+        	SequentialCoveringWithPreferences scwp(know, context);
         	rules = scwp.generateRules(examples, *rqmGrowPtr, *rqmPrunePtr);
         }
-        RuleClassifier ruleClassifier(rules);
+        //optional compaction: "votes" - only if the training predictions stay the same, "all" - always
+        if(params.containsElementNamed("compact") && Rcpp::as<string>(params["compact"]) != "none")
+        {
+        	RuleSetCompaction compaction;
+        	compaction.compact(rules, Rcpp::as<string>(params["compact"]) == "all" ? NULL : &examples);
+        	context.log(compaction.toString());
+        }
+        RuleClassifier ruleClassifier(std::move(rules));
 
-        Rcpp::List result = serializeRules(ruleClassifier, examples);
+        Rcpp::List result = serializeRules(ruleClassifier, examples, context);
+        if(!AllocationCounter::report().empty())
+            context.log(AllocationCounter::report());
         delete ds;
         delete rqmGrowPtr;
         delete rqmPrunePtr;
@@ -50,8 +68,7 @@ Rcpp::List RInterface::generateRules(Rcpp::List params)
     }
     catch (RulesInductionException& ex)
     {
-        cout << "Exception occured: " << ex.getMessage() << endl;
-        return Rcpp::List();
+        Rcpp::stop(ex.getMessage());
     }
     return 0;
 }
@@ -67,18 +84,22 @@ Rcpp::List RInterface::generateRules(Rcpp::List params)
  * @param xlevels 2-dim table of unique values of conditional attributes
  * @param _serialRules vector of strings representing rules
  * @param confidenceDegrees vector of confidence degree for each rule
+ * @param model binary representation of rules (NULL for models created by older versions of the package)
+ * @param handle compiled rules returned by the previous call (external pointer) or NULL
  * @param weights vector of case weights
- * @return predicted class values and statistics of classification
+ * @return predicted class values, statistics of classification and compiled rules
  */
 Rcpp::List RInterface::predict(Rcpp::List params)
 {
+    ThreadCachesScope caches;
     try
     {
-    	srand ( Rcpp::as<double>(params["seed"]) *  numeric_limits<unsigned int>::max());
+    	InductionContext context(createInductionContext(params));
+    	AllocationCounter::reset();
         DataSet* ds = createDataSet(params);
         SetOfExamples examples(*ds, true);
-        RuleClassifier ruleClassifier(deserializeRules(Rcpp::as<vector<string> >(params["rules"]),
-        												Rcpp::as<vector<double> >(params["confidenceDegrees"]), *ds));
+        Rcpp::XPtr<RuleClassifier> handle = getCompiledRules(params, *ds);
+        RuleClassifier& ruleClassifier = *handle;
 
         vector<double> predictions = ruleClassifier.classifyExamples(examples);
         double acc = numeric_limits<double>::quiet_NaN();
@@ -98,19 +119,101 @@ Rcpp::List RInterface::predict(Rcpp::List params)
                                                Rcpp::Named("cov", cov), Rcpp::Named("predictions", predictions),
                                                Rcpp::Named("confusionMatrix", cm.getMatrix()),
                                                Rcpp::Named("classesAccuracies", classesAccuracies),
-                                               Rcpp::Named("unclassified", cm.getUnclassified()));
+                                               Rcpp::Named("unclassified", cm.getUnclassified()),
+                                               Rcpp::Named("handle", handle));
+        if(!AllocationCounter::report().empty())
+            context.log(AllocationCounter::report());
         delete ds;
         return result;
     }
     catch (RulesInductionException& ex)
     {
-        cout << "Exception occured: " << ex.getMessage() << endl;
-        return Rcpp::List();
+        Rcpp::stop(ex.getMessage());
     }
     return 0;
 }
 
-
+
+
+/**
+ * Updates rules after new examples were appended to their training set (see SequentialCovering::updateRules)
+ * @param y vector of decision attribute values of the whole training set (old examples followed by new ones)
+ * @param x values of conditional attributes of the whole training set
+ * @param rules vector of strings representing rules
+ * @param confidenceDegrees vector of confidence degree for each rule
+ * @param model binary representation of rules
+ * @param counts numbers of examples covered by the rules on the old examples (matrix with columns P, p, N and n)
+ * @param appended number of new examples (the last rows of the data)
+ * @param repruneThreshold change of the quality of a rule above which the rule is pruned again
+ * @return representation of updated rules and their statistics
+ */
+Rcpp::List RInterface::updateRules(Rcpp::List params)
+{
+    ThreadCachesScope caches;
+    try
+    {
+        InductionContext context(createInductionContext(params));
+        AllocationCounter::reset();
+        DataSet* ds = createDataSet(params);
+        SetOfExamples examples(*ds, true);
+        int appended = Rcpp::as<int>(params["appended"]);
+        if (appended < 0 || appended > examples.size())
+            throw RulesInductionException("Number of appended examples cannot be negative or greater than number of examples");
+        SetOfExamples newExamples(*ds);
+        for (int i = examples.size() - appended; i < examples.size(); i++)
+            newExamples.addExample(examples, i);
+
+        RuleClassifier oldRules(loadRules(params, *ds));
+        list<Rule>& rules = oldRules.getRules();
+        if (Rf_isNull((SEXP)params["counts"]))
+            throw RulesInductionException("Rules cannot be updated without the numbers of examples covered by them");
+        Rcpp::NumericMatrix counts((SEXP)params["counts"]);
+        if (counts.nrow() != (int)rules.size() || counts.ncol() != 4)
+            throw RulesInductionException("Numbers of examples covered by rules do not match the rules");
+        int i = 0;
+        for (list<Rule>::iterator it = rules.begin(); it != rules.end(); it++, i++)
+            it->setEvaluationResult(RuleEvaluationResult(counts(i, 0), counts(i, 1), counts(i, 2), counts(i, 3)));
+
+        RuleQualityMeasure* rqmGrowPtr = createRuleQualityMeasure(Rcpp::as<string>(params["qsplit"]), (SEXP)params["qsplitfun"]);
+        RuleQualityMeasure* rqmPrunePtr = createRuleQualityMeasure(Rcpp::as<string>(params["q"]), (SEXP)params["qfun"]);
+        SequentialCovering sc(context);
+        RuleClassifier ruleClassifier(sc.updateRules(rules, examples, newExamples, *rqmGrowPtr, *rqmPrunePtr,
+                                                     Rcpp::as<double>(params["repruneThreshold"])));
+
+        Rcpp::List result = serializeRules(ruleClassifier, examples, context);
+        if(!AllocationCounter::report().empty())
+            context.log(AllocationCounter::report());
+        delete ds;
+        delete rqmGrowPtr;
+        delete rqmPrunePtr;
+        return result;
+    }
+    catch (RulesInductionException& ex)
+    {
+        Rcpp::stop(ex.getMessage());
+    }
+    return 0;
+}
+
+/**
+ * Creates the context of the induction: the random number generator seeded from R, messages written
+ * to the console and the settings
+ * @param seed seed of the random number generator from [0, 1)
+ * @param growSampleSize maximal number of negative examples used in the growth of a rule (may be absent)
+ * @return context
+ */
+InductionContext RInterface::createInductionContext(Rcpp::List& params)
+{
+    InductionContext context((uint64_t)(Rcpp::as<double>(params["seed"]) * numeric_limits<unsigned int>::max()));
+    context.setLogStream(&Rcpp::Rcout);
+    if (params.containsElementNamed("growSampleSize"))
+    {
+        double size = Rcpp::as<double>(params["growSampleSize"]);
+        if (size >= 1 && size < numeric_limits<int>::max())
+            context.setGrowSampleSize((int)size);
+    }
+    return context;
+}
 
 /**
  * Creates DataSet object from data passed from R
@@ -126,6 +229,22 @@ Rcpp::List RInterface::predict(Rcpp::List params)
 DataSet* RInterface::createDataSet(Rcpp::List& params)
 {
     DataSet* ds = new DataSet();
+    //columns exceeding the limit (in megabytes) are kept in a memory-mapped temporary file
+    if (params.containsElementNamed("memoryLimit") && params.containsElementNamed("tempdir"))
+    {
+        double memoryLimit = Rcpp::as<double>(params["memoryLimit"]);
+        if (memoryLimit < numeric_limits<double>::infinity())
+        {
+            ds->setMemoryBudget(memoryLimit > 0 ? (size_t)(memoryLimit * 1024 * 1024) : 0);
+            ds->setSpillDirectory(Rcpp::as<string>(params["tempdir"]));
+        }
+    }
+    //numerical columns with a lower fraction of values other than zero (or NA) are stored as sparse columns
+    if (params.containsElementNamed("sparseDensity"))
+        ds->setMaxSparseDensity(Rcpp::as<double>(params["sparseDensity"]));
+    //integer columns and codes of nominal attributes are stored as narrower types anyway
+    if (params.containsElementNamed("singlePrecision"))
+        ds->setSinglePrecision(Rcpp::as<bool>(params["singlePrecision"]));
 
     vector<double> y = Rcpp::as<vector<double> >(params["y"]);
         ds->setDecisionAttributeIndex(0);
@@ -172,10 +291,10 @@ DataSet* RInterface::createDataSet(Rcpp::List& params)
 /**
  * "Serializes" RuleClassifier object to object proper R object
  * @param rules RuleClassifier object with inner representation of rules
- * @param examples set of examples used for computing rule statistics
+ * @param examples training set of the rules (used for computing rule statistics)
  * @return list whith representation of rules that may be used in R
  */
-Rcpp::List RInterface::serializeRules(RuleClassifier& rules, SetOfExamples& examples)
+Rcpp::List RInterface::serializeRules(RuleClassifier& rules, SetOfExamples& examples, InductionContext& context)
 {
     vector<string> serialRules;
     vector<double> confidenceDegrees;
@@ -185,17 +304,66 @@ Rcpp::List RInterface::serializeRules(RuleClassifier& rules, SetOfExamples& exam
         serialRules.push_back(itRulePtr->toString(examples.getDataSet()));
         confidenceDegrees.push_back(itRulePtr->getConfidenceDegree());
     }
-    RuleSetStats stats = rules.getRuleSetStats(examples);
+    RuleSetStats stats = rules.getRuleSetStats(examples, true);
+    vector<unsigned char> model = BinaryModel::encode(rules.getRules(), examples.getDataSet());
 
     if(stats.warning)
-        cout << "warning: p-value has been calculated for weighted examples." << endl;
+        context.log("warning: p-value has been calculated for weighted examples.");
+
+    //numbers of examples covered by the rules allow to update them with new examples
+    Rcpp::NumericMatrix counts((int)stats.results.size(), 4);
+    for (size_t i = 0; i < stats.results.size(); i++)
+    {
+        counts(i, 0) = stats.results[i].P;
+        counts(i, 1) = stats.results[i].p;
+        counts(i, 2) = stats.results[i].N;
+        counts(i, 3) = stats.results[i].n;
+    }
+    counts.attr("dimnames") = Rcpp::List::create(R_NilValue, Rcpp::CharacterVector::create("P", "p", "N", "n"));
 
     return Rcpp::List::create(Rcpp::Named("Rules", serialRules),
                               Rcpp::Named("ConfidenceDegrees", confidenceDegrees),
                               Rcpp::Named("NumbersOfConditions", stats.condCounts),
                               Rcpp::Named("RulesPrecisions", stats.precs),
                               Rcpp::Named("RulesCoverages", stats.covs),
-                              Rcpp::Named("Pvalues", stats.pvalues));
+                              Rcpp::Named("Pvalues", stats.pvalues),
+                              Rcpp::Named("Model", Rcpp::RawVector(model.begin(), model.end())),
+                              Rcpp::Named("Counts", counts));
+}
+
+/**
+ * Returns compiled rules passed from R as an external pointer. If the pointer is not available
+ * (first prediction or the pointer has been lost when the R object was saved and loaded) or it was
+ * compiled from other rules (the cache is shared by copies of the R object, which may be modified),
+ * the rules are compiled again; the pointer owns the rules and deletes them when it is garbage collected.
+ * @param params parameters passed from R
+ * @param ds data set the rules will be applied to
+ * @return external pointer to RuleClassifier object; its tag holds the parameters the rules were compiled from
+ */
+Rcpp::XPtr<RuleClassifier> RInterface::getCompiledRules(Rcpp::List& params, DataSet& ds)
+{
+    Rcpp::List key = Rcpp::List::create(params["model"], params["rules"], params["confidenceDegrees"],
+                                        params["ylevels"], params["xlevels"]);
+    SEXP handle = params["handle"];
+    if(TYPEOF(handle) == EXTPTRSXP && R_ExternalPtrAddr(handle) != NULL && R_compute_identical(R_ExternalPtrTag(handle), key, 16))
+        return Rcpp::XPtr<RuleClassifier>(handle);
+    return Rcpp::XPtr<RuleClassifier>(new RuleClassifier(loadRules(params, ds)), true, key);
+}
+
+/**
+ * Restores rules passed from R. Uses binary representation of rules if it is available,
+ * otherwise parses text representation of rules.
+ * @param params parameters passed from R
+ * @param ds data set the rules will be applied to
+ * @return RuleClassifier object with inner representation of rules
+ */
+RuleClassifier RInterface::loadRules(Rcpp::List& params, DataSet& ds)
+{
+    if(Rf_isNull((SEXP)params["model"]))
+        return deserializeRules(Rcpp::as<vector<string> >(params["rules"]),
+                                Rcpp::as<vector<double> >(params["confidenceDegrees"]), ds);
+    Rcpp::RawVector model((SEXP)params["model"]);
+    return RuleClassifier(BinaryModel::decode(model.begin(), model.size(), ds));
 }
 
 /**
@@ -212,14 +380,14 @@ RuleClassifier RInterface::deserializeRules(vector<string> _serialRules, vector<
     {
         Rule rule(Rule::parseRule(ds, _serialRules[i]));
         rule.setConfidenceDegree(confidenceDegrees[i]);
-        ruleClassifier.addRule(rule);
+        ruleClassifier.addRule(std::move(rule));
     }
     return ruleClassifier;
 }
 
 /**
  * Creates proper RuleQualityMeasure object based on its name
- * @param name name of measure
+ * @param name name of measure or its formula in P, p, N and n (see ExpressionMeasure)
  * @param customRqm function passed from R to be used as rqm
  * @return pointer to created RuleQualityMeasure object
  */
@@ -238,7 +406,7 @@ RuleQualityMeasure* RInterface::createRuleQualityMeasure(string name, SEXP custo
     if (name == "cn2") return new Cn2();
     if (name == "gain") return new Gain();
     if (name.empty()) return new CustomMeasure(customRqm);
-    return NULL;
+    return new ExpressionMeasure(name);
 }
 
 /**
@@ -246,9 +414,11 @@ RuleQualityMeasure* RInterface::createRuleQualityMeasure(string name, SEXP custo
 */
 Rcpp::List RInterface::crossValidation(Rcpp::List params)
 {
+    ThreadCachesScope caches;
     try
     {
-    	srand ( Rcpp::as<double>(params["seed"]) *  numeric_limits<unsigned int>::max());
+    	InductionContext context(createInductionContext(params));
+    	AllocationCounter::reset();
 		//creating data set
 		DataSet* ds = createDataSet(params);
 		SetOfExamples examples(*ds, true);
@@ -261,22 +431,21 @@ Rcpp::List RInterface::crossValidation(Rcpp::List params)
 		bool useWeightsInPrediction = Rcpp::as<bool>(params["useWeightsInPrediction"]);
 
         //wygenerowanie reguł
-        SequentialCovering sc;
+        SequentialCovering sc(context);
         Rcpp::List result;
 
         for (int i = 0; i < runs; i++)
         {
             Rcpp::List runResult;
-            vector<SetOfExamples> folds = examples.createStratifiedFolds(nfolds, everyClassInFold);
+            vector<SetOfExamples> folds = examples.createStratifiedFolds(nfolds, everyClassInFold, context.getRandom());
             for (int j = 0; j < nfolds; j++)
             {
                 //induction
                 Rcpp::List foldResult;
-                SetOfExamples testSet = folds[j];
+                SetOfExamples& testSet = folds[j];
                 SetOfExamples trainSet = examples - testSet;
-                list<Rule> rules = sc.generateRules(trainSet, *rqmGrowPtr, *rqmPrunePtr);
-                RuleClassifier ruleClassifier(rules);
-                foldResult.push_back(serializeRules(ruleClassifier, trainSet));
+                RuleClassifier ruleClassifier(sc.generateRules(trainSet, *rqmGrowPtr, *rqmPrunePtr));
+                foldResult.push_back(serializeRules(ruleClassifier, trainSet, context));
                 //prediction
                 vector<double> predictions = ruleClassifier.classifyExamples(testSet);
                 ConfusionMatrix cm(0);
@@ -297,6 +466,8 @@ Rcpp::List RInterface::crossValidation(Rcpp::List params)
             }
             result.push_back(runResult);
         }
+        if(!AllocationCounter::report().empty())
+            context.log(AllocationCounter::report());
         delete ds;
         delete rqmGrowPtr;
         delete rqmPrunePtr;
@@ -304,12 +475,111 @@ Rcpp::List RInterface::crossValidation(Rcpp::List params)
     }
     catch (RulesInductionException& ex)
     {
-        cout << "Exception occured: " << ex.getMessage() << endl;
-        return Rcpp::List();
+        Rcpp::stop(ex.getMessage());
     }
     return 0;
 }
 
+/**
+ * Evaluates pairs of rule quality measures for the automatic selection of measures. The data set and
+ * the folds (or the training and the validation set) are created once for all the pairs.
+ * @param qPruneSet names of measures to be used in pruning phase (empty names for measures defined in R)
+ * @param qPruneFuns measures defined in R (NULL for named measures)
+ * @param qGrowSet names of measures to be used in growing phase
+ * @param qGrowFuns measures defined in R used in growing phase
+ * @param byPair true if the i-th pruning measure is evaluated only with the i-th growing measure
+ * @param folds number of folds of cross-validation
+ * @param trainIndices indices (starting from 1) of the examples of the training set; if not empty, the other
+ * examples form the validation set and folds are not used
+ * @param criterion criterion of racing ("acc", "bac" or "g-mean")
+ * @param racingFolds number of folds the pairs are evaluated on in the first round of racing
+ * @param racingFactor ratio of the numbers of folds in successive rounds of racing, 0 if racing is not used
+ * @return mean accuracies, balanced accuracies, g-means and numbers of evaluated folds of the pairs
+ * (pruning measures in the outer loop)
+ */
+Rcpp::List RInterface::selectMeasures(Rcpp::List params)
+{
+    ThreadCachesScope caches;
+    vector<RuleQualityMeasure*> measures;
+    DataSet* ds = NULL;
+    try
+    {
+        InductionContext context(createInductionContext(params));
+        AllocationCounter::reset();
+        ds = createDataSet(params);
+        SetOfExamples examples(*ds, true);
+
+        vector<string> pruneNames = Rcpp::as<vector<string> >(params["qPruneSet"]);
+        vector<string> growNames = Rcpp::as<vector<string> >(params["qGrowSet"]);
+        Rcpp::List pruneFuns = params["qPruneFuns"];
+        Rcpp::List growFuns = params["qGrowFuns"];
+        bool byPair = Rcpp::as<bool>(params["byPair"]);
+        if (byPair && pruneNames.size() != growNames.size())
+            throw RulesInductionException("Vectors of rule quality measures' names are not of equal length!");
+        for (size_t i = 0; i < pruneNames.size(); i++)
+            measures.push_back(createRuleQualityMeasure(pruneNames[i], (SEXP)pruneFuns[i]));
+        for (size_t i = 0; i < growNames.size(); i++)
+            measures.push_back(createRuleQualityMeasure(growNames[i], (SEXP)growFuns[i]));
+
+        MeasureSelection selection(context);
+        vector<int> trainIndices = Rcpp::as<vector<int> >(params["trainIndices"]);
+        if (!trainIndices.empty())
+        {
+            //the training set keeps the order of the indices (as the data set built in R from these rows)
+            SetOfExamples trainSet(*ds);
+            for (size_t i = 0; i < trainIndices.size(); i++)
+                trainSet.addExample(examples, trainIndices[i] - 1);
+            SetOfExamples sortedTrainSet(trainSet);
+            selection.addSplit(trainSet, examples - sortedTrainSet);
+        }
+        else
+        {
+            vector<SetOfExamples> folds = examples.createStratifiedFolds(Rcpp::as<int>(params["folds"]), true, context.getRandom());
+            for (size_t j = 0; j < folds.size(); j++)
+                selection.addSplit(examples - folds[j], folds[j]);
+        }
+
+        //measures defined in R (with empty names) are called only from this thread
+        for (size_t i = 0; i < pruneNames.size(); i++)
+            for (size_t j = byPair ? i : 0; j < (byPair ? i + 1 : growNames.size()); j++)
+                selection.addPair(measures[pruneNames.size() + j], measures[i], !pruneNames[i].empty() && !growNames[j].empty());
+        double racingFactor = Rcpp::as<double>(params["racingFactor"]);
+        if (racingFactor > 1 && selection.getNumberOfSplits() > 1)
+        {
+            string criterion = Rcpp::as<string>(params["criterion"]);
+            selection.race(criterion == "acc" ? MeasureSelection::ACCURACY
+                                              : (criterion == "bac" ? MeasureSelection::AVG_ACCURACY : MeasureSelection::GMEAN),
+                           Rcpp::as<int>(params["racingFolds"]), racingFactor);
+        }
+        else
+            selection.evaluate();
+
+        vector<double> acc, bac, gmean;
+        vector<int> evaluatedFolds;
+        for (int i = 0; i < selection.getNumberOfPairs(); i++)
+        {
+            acc.push_back(selection.getAccuracy(i));
+            bac.push_back(selection.getAvgAccuracy(i));
+            gmean.push_back(selection.getGmean(i));
+            evaluatedFolds.push_back(selection.getNumberOfEvaluatedSplits(i));
+        }
+        if(!AllocationCounter::report().empty())
+            context.log(AllocationCounter::report());
+        for (size_t i = 0; i < measures.size(); i++)
+            delete measures[i];
+        delete ds;
+        return Rcpp::List::create(Rcpp::Named("acc", acc), Rcpp::Named("bac", bac), Rcpp::Named("gmean", gmean),
+                                  Rcpp::Named("folds", evaluatedFolds));
+    }
+    catch (RulesInductionException& ex)
+    {
+        for (size_t i = 0; i < measures.size(); i++)
+            delete measures[i];
+        delete ds;
+        Rcpp::stop(ex.getMessage());
+    }
+}
+
 double RInterface::decrement(double value)
 {
 	return --value;
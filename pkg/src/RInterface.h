@@ -16,6 +16,12 @@
 #include "Knowledge.h"
 #include "KnowledgeCondition.h"
 #include "KnowledgeRule.h"
+#include "MemoryPool.h"
+#include "BinaryModel.h"
+#include "ExpressionMeasure.h"
+#include "MeasureSelection.h"
+#include "RuleSetCompaction.h"
+#include "InductionContext.h"
 #include <map>
 #include <list>
 #include <Rcpp.h>
@@ -36,9 +42,16 @@ public:
 
     Rcpp::List crossValidation(Rcpp::List params);
 
+    Rcpp::List selectMeasures(Rcpp::List params);
+
+    Rcpp::List updateRules(Rcpp::List params);
+
 private:
     DataSet* createDataSet(Rcpp::List& params);
-    Rcpp::List serializeRules(RuleClassifier& rules, SetOfExamples& examples);
+    InductionContext createInductionContext(Rcpp::List& params);
+    Rcpp::List serializeRules(RuleClassifier& rules, SetOfExamples& examples, InductionContext& context);
+    Rcpp::XPtr<RuleClassifier> getCompiledRules(Rcpp::List& params, DataSet& ds);
+    RuleClassifier loadRules(Rcpp::List& params, DataSet& ds);
     RuleClassifier deserializeRules(std::vector<std::string> _serialRules, std::vector<double> confidenceDegrees, DataSet& ds);
     double resolveConflict(std::list<Rule*>&);
     RuleQualityMeasure* createRuleQualityMeasure(std::string name, SEXP customRqm);
@@ -56,6 +69,8 @@ RCPP_MODULE(crules_mod) {
             .method("generateRules", &RInterface::generateRules, "Generates decision rules using sequential covering")
             .method("predict", &RInterface::predict, "Predicts class values")
             .method("crossValidation", &RInterface::crossValidation, "Performs n runs of k-fold cross-validation")
+            .method("selectMeasures", &RInterface::selectMeasures, "Evaluates pairs of rule quality measures on common folds")
+            .method("updateRules", &RInterface::updateRules, "Updates rules with examples appended to the training set")
             ;
 
 }
@@ -63,17 +78,36 @@ RCPP_MODULE(crules_mod) {
 
 /**
  * Represents custom measure defined by user in R.
+ * If the R function has attribute "vectorized" set to TRUE (the user declares that it computes
+ * the measure element-wise for vectors of P, p, N and n), many results are evaluated by one call
+ * of the function. Otherwise the function is called separately for every result.
  */
 class CustomMeasure: public RuleQualityMeasure
 {
 public:
-    CustomMeasure(Rcpp::Function& _rFunction): rFunction(_rFunction) {}
-    CustomMeasure(SEXP rFunctionPtr): rFunction(rFunctionPtr) {}
+    CustomMeasure(Rcpp::Function& _rFunction): rFunction(_rFunction), vectorized(isVectorized(_rFunction)) {}
+    CustomMeasure(SEXP rFunctionPtr): rFunction(rFunctionPtr), vectorized(isVectorized(rFunctionPtr)) {}
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return Rcpp::as<double>(rFunction(Rcpp::Named("P", r.P), Rcpp::Named("p", r.p), Rcpp::Named("N", r.N), Rcpp::Named("n", r.n)));
     }
+    void EvaluateRuleQualityFromResults(const RuleEvaluationResults& r, std::vector<double>& qualities) {
+        if (!vectorized || r.size() == 0)
+        {
+            RuleQualityMeasure::EvaluateRuleQualityFromResults(r, qualities);
+            return;
+        }
+        qualities = Rcpp::as<std::vector<double> >(rFunction(Rcpp::Named("P", r.P), Rcpp::Named("p", r.p),
+                                                             Rcpp::Named("N", r.N), Rcpp::Named("n", r.n)));
+        if (qualities.size() != r.size())
+            throw RulesInductionException("Custom measure marked as vectorized returned a vector of a different length than its arguments");
+    }
 private:
+    static bool isVectorized(SEXP rFunctionPtr) {
+        return Rf_asLogical(Rf_getAttrib(rFunctionPtr, Rf_install("vectorized"))) == TRUE;
+    }
+
     Rcpp::Function rFunction;
+    bool vectorized;    /**< true if the function is called once for many results*/
 };
 #endif	/* RINTERFACE_H */
 
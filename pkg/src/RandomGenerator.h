@@ -0,0 +1,59 @@
+#ifndef RANDOMGENERATOR_H
+#define	RANDOMGENERATOR_H
+
+#include <stdint.h>
+
+/**
+ * Pseudo-random number generator (SplitMix64) owned by an induction context instead of the global
+ * state of rand(). The generator is splittable: independent streams are derived from its state
+ * by an index, so parallel tasks get the same numbers whatever thread runs them.
+ */
+class RandomGenerator
+{
+public:
+    explicit RandomGenerator(uint64_t seed = 0) : state(seed) {}
+
+    /** @return next 64 random bits*/
+    uint64_t next()
+    {
+        return mix(state += GOLDEN_GAMMA);
+    }
+
+    /**
+     * @param bound number of values (greater than zero)
+     * @return random integer from [0, bound)
+     */
+    int nextInt(int bound)
+    {
+        return (int)(((next() >> 32) * (uint64_t)bound) >> 32);
+    }
+
+    /** @return random number from [0, 1)*/
+    double nextDouble()
+    {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * Derives an independent generator; the generator itself is not advanced
+     * @param stream index of the stream
+     * @return generator of the stream
+     */
+    RandomGenerator split(uint64_t stream) const
+    {
+        return RandomGenerator(mix(state + mix(stream + GOLDEN_GAMMA)));
+    }
+private:
+    static const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t state;
+};
+
+#endif	/* RANDOMGENERATOR_H */
@@ -8,6 +8,7 @@ using namespace std;
  */
 void Rule::addCondition(ElementaryCondition& newCondition) {
 	unsigned int attIndex = newCondition.getAttributeIndex();
+	evaluated = false;
 	if (attIndex + 1 > conditions.size())
 		conditions.resize(attIndex + 1);
 	conditions[attIndex].push_back(newCondition);
@@ -20,6 +21,7 @@ void Rule::addCondition(ElementaryCondition& newCondition) {
 void Rule::addConditionAndOptimize(ElementaryCondition& newCondition) {
 	list<ElementaryCondition>::iterator it;
 	unsigned int attIndex = newCondition.getAttributeIndex();
+	evaluated = false;
 	if (attIndex + 1 > conditions.size()) {
 		conditions.resize(attIndex + 1);
 		conditions[attIndex].push_back(newCondition);
@@ -55,6 +57,7 @@ void Rule::addConditionAndOptimize(ElementaryCondition& newCondition) {
 void Rule::removeCondition(ElementaryCondition& condition) {
 	int attIndex = condition.getAttributeIndex();
 	list<ElementaryCondition>::iterator it;
+	evaluated = false;
 	for (it = conditions[attIndex].begin(); it != conditions[attIndex].end();
 			it++) {
 		if (*it == condition) {
@@ -65,11 +68,24 @@ void Rule::removeCondition(ElementaryCondition& condition) {
 }
 
 Rule& Rule::operator =(const Rule& orig) {
-	if (*this == orig)
+	if (this == &orig)
 		return *this;
 	conditions = orig.conditions;
 	setDecisionClass(orig.decisionClass);
 	setConfidenceDegree(orig.confidenceDegree);
+	evaluationResult = orig.evaluationResult;
+	evaluated = orig.evaluated;
+	return *this;
+}
+
+Rule& Rule::operator =(Rule&& orig) {
+	if (this == &orig)
+		return *this;
+	conditions = std::move(orig.conditions);
+	setDecisionClass(orig.decisionClass);
+	setConfidenceDegree(orig.confidenceDegree);
+	evaluationResult = orig.evaluationResult;
+	evaluated = orig.evaluated;
 	return *this;
 }
 
@@ -86,9 +102,9 @@ bool Rule::operator ==(const Rule& secondRule) {
  * @param example example
  * @return true - if the rule covers an example; fałsz - otherwise
  */
-bool Rule::covers(Example& example) {
-	list<ElementaryCondition>::iterator itCond;
-	vector<list<ElementaryCondition> >::iterator itVec;
+bool Rule::covers(Example& example) const {
+	list<ElementaryCondition>::const_iterator itCond;
+	vector<list<ElementaryCondition> >::const_iterator itVec;
 	for (itVec = conditions.begin(); itVec != conditions.end(); itVec++) {
 		for (itCond = itVec->begin(); itCond != itVec->end(); itCond++) {
 			if (!(itCond->isSatisfied(
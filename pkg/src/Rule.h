@@ -6,6 +6,7 @@
 #include "DataSet.h"
 #include "UsefulFunctions.h"
 #include "RulesInductionException.h"
+#include "RuleEvaluationResult.h"
 #include <vector>
 #include <set>
 
@@ -19,18 +20,19 @@
 class Rule {
 public:
 	Rule() :
-			decisionClass(0), confidenceDegree(0) {
+			decisionClass(0), confidenceDegree(0), evaluated(false) {
 	}
 	;
 	Rule(int noOfAttributes) :
-			conditions(noOfAttributes), decisionClass(0), confidenceDegree(0) {
+			conditions(noOfAttributes), decisionClass(0), confidenceDegree(0), evaluated(false) {
 	}
-	//Rule(const Rule& orig);
-	bool covers(Example&);
+	Rule(const Rule& orig) = default;
+	Rule(Rule&& orig) = default;
+	bool covers(Example&) const;
 	void setDecisionClass(double decisionClass) {
 		this->decisionClass = decisionClass;
 	}
-	double getDecisionClass() {
+	double getDecisionClass() const {
 		return decisionClass;
 	}
 	std::vector<std::list<ElementaryCondition> >& getConditions() {
@@ -41,20 +43,38 @@ public:
 	void removeCondition(ElementaryCondition& condition);
 	bool operator==(const Rule& secondRule);
 	Rule& operator=(const Rule& orig);
+	Rule& operator=(Rule&& orig);
 	std::string toString();
 	std::string toString(DataSet& ds);
-	double getConfidenceDegree() {
+	double getConfidenceDegree() const {
 		return confidenceDegree;
 	}
 	void setConfidenceDegree(double cd) {
 		confidenceDegree = cd;
 	}
+	/**
+	 * Stores result of the evaluation of the rule on the training set (computed when the rule is accepted
+	 * by the induction). The result is discarded when conditions of the rule change.
+	 * @param result result of the evaluation
+	 */
+	void setEvaluationResult(const RuleEvaluationResult& result) {
+		evaluationResult = result;
+		evaluated = true;
+	}
+	const RuleEvaluationResult& getEvaluationResult() const {
+		return evaluationResult;
+	}
+	bool isEvaluated() const {
+		return evaluated;
+	}
 	bool containsCondition(ElementaryCondition& condition);
 	static Rule parseRule(DataSet& ds, std::string ruleStr);
 private:
 	std::vector<std::list<ElementaryCondition> > conditions;
 	double decisionClass;
 	double confidenceDegree;
+	RuleEvaluationResult evaluationResult;
+	bool evaluated;
 };
 
 #endif	/* RULE_H */
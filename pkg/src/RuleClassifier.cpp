@@ -7,11 +7,24 @@ using namespace std;
  * @param example example to be classified
  * @return predicted class value
  */
-double RuleClassifier::classifyExample(Example& example)
+double RuleClassifier::classifyExample(Example& example) const
+{
+	vector<const Rule*> coveringRules;
+	for(list<Rule>::const_iterator it = rules.begin(); it != rules.end(); it++)
+		if(it->covers(example))
+			coveringRules.push_back(&*it);
+	return classify(coveringRules);
+}
+
+/**
+ * Picks the class of an example by the rules covering it
+ * @param coveringRules rules covering the example, in the order of the rule list
+ * @return predicted class value (NaN if no rule covers the example)
+ */
+double RuleClassifier::classify(vector<const Rule*>& coveringRules)
 {
-	list<Rule> coveringRules(getCoveringRules(example));
 	if(coveringRules.size() == 1)
-		return coveringRules.front().getDecisionClass();
+		return coveringRules.front()->getDecisionClass();
 	if(coveringRules.size() > 1)
 		return resolveConflict(coveringRules);
 	//if no rule covers the example
@@ -25,19 +38,19 @@ and then the class with maximal confidence degree is picked.
 /**
 * Resolves conflict when the example is covered by more than one rule.
 * Uses voting strategy, in which the voting power of each rule is its confidence degree.
-  * @param coveringRules list of rules covering an example.
+  * @param coveringRules rules covering an example, in the order of the rule list.
   * @return predicted class value
  */
-double RuleClassifier::resolveConflict(list<Rule>& coveringRules)
+double RuleClassifier::resolveConflict(vector<const Rule*>& coveringRules)
 {//voting scheme:
 	map<double, double> sumsOfConfidenceDegress;	//one item per class
 	map<double, double>::iterator itMap;
-	list<Rule>::iterator it;
+	vector<const Rule*>::iterator it;
 	double decisionClass, confidenceDegree;
 	for(it = coveringRules.begin(); it != coveringRules.end(); it++)
 	{
-		decisionClass = it->getDecisionClass();
-		confidenceDegree = it->getConfidenceDegree();
+		decisionClass = (*it)->getDecisionClass();
+		confidenceDegree = (*it)->getConfidenceDegree();
 		itMap = sumsOfConfidenceDegress.find(decisionClass);
 		if(itMap == sumsOfConfidenceDegress.end())
 			sumsOfConfidenceDegress[decisionClass] = confidenceDegree;
@@ -56,18 +69,169 @@ double RuleClassifier::resolveConflict(list<Rule>& coveringRules)
 }
 
 /**
- * Performs classification of a set of examples
+ * Performs classification of a set of examples. If the rules have not changed since the voting
+ * was prepared, the voting of the rules stops early for most examples (see prepareVoting).
  * @param examples set of examples to be classified
  * @return vector of predicted class values
  */
-vector<double> RuleClassifier::classifyExamples(SetOfExamples& examples)
+vector<double> RuleClassifier::classifyExamples(SetOfExamples& examples) const
 {
+    AllocationPhase phase(AllocationCounter::PREDICT);
     vector<double> predictions(examples.size(), numeric_limits<double>::quiet_NaN());
+    if (!votingPrepared)
+    {
+        for(int i = 0; i < examples.size(); i++)
+            predictions[i] = classifyExample(examples[i]);
+        return predictions;
+    }
+    vector<double> sums(numberOfClasses);
+    vector<int> covering;
     for(int i = 0; i < examples.size(); i++)
-        predictions[i] = classifyExample(examples[i]);
+        predictions[i] = vote(examples[i], sums, covering);
     return predictions;
 }
 
+RuleClassifier& RuleClassifier::operator=(const RuleClassifier& orig)
+{
+    if (this != &orig)
+    {
+        rules = orig.rules;
+        prepareVoting();
+    }
+    return *this;
+}
+
+RuleClassifier& RuleClassifier::operator=(RuleClassifier&& orig)
+{
+    if (this != &orig)
+    {
+        rules = std::move(orig.rules);
+        prepareVoting();
+        orig.prepareVoting();
+    }
+    return *this;
+}
+
+/**
+ * Prepares the voting of the rules for classifyExamples: orders the rules by descending confidence degree
+ * and sums up the confidence degrees which the rules from every position of the order on can still give
+ * to every class, so the voting may stop as soon as the remaining rules cannot change its result.
+ * Called whenever the rules are set; has to be called after the rules are changed through getRules
+ * or added by addRule and addRules.
+ */
+void RuleClassifier::prepareVoting()
+{
+    ruleVector.clear();
+    for (list<Rule>::const_iterator it = rules.begin(); it != rules.end(); it++)
+        ruleVector.push_back(&*it);
+    int numberOfRules = ruleVector.size();
+
+    vector<pair<double, int> > confidences(numberOfRules);
+    for (int r = 0; r < numberOfRules; r++)
+        confidences[r] = make_pair(-ruleVector[r]->getConfidenceDegree(), r);
+    earlyExit = true;
+    double sumOfConfidences = 0;
+    for (int r = 0; r < numberOfRules; r++)
+    {
+        double confidence = ruleVector[r]->getConfidenceDegree();
+        if (confidence != confidence || fabs(confidence) > numeric_limits<double>::max())
+            earlyExit = false;
+        else
+            sumOfConfidences += fabs(confidence);
+        if (!earlyExit)
+            confidences[r].first = 0;
+    }
+    if (earlyExit)
+        stable_sort(confidences.begin(), confidences.end());
+
+    map<double, int> classIndices;
+    votingOrder.resize(numberOfRules);
+    votingClasses.resize(numberOfRules);
+    for (int k = 0; k < numberOfRules; k++)
+    {
+        votingOrder[k] = confidences[k].second;
+        double decisionClass = ruleVector[votingOrder[k]]->getDecisionClass();
+        map<double, int>::iterator itClass = classIndices.find(decisionClass);
+        if (itClass == classIndices.end())
+            itClass = classIndices.insert(make_pair(decisionClass, (int)classIndices.size())).first;
+        votingClasses[k] = itClass->second;
+    }
+    numberOfClasses = classIndices.size();
+
+    remainingVotes.assign((numberOfRules + 1) * numberOfClasses, 0.0);
+    remainingNegativeVotes.assign((numberOfRules + 1) * numberOfClasses, 0.0);
+    if (earlyExit)
+        for (int k = numberOfRules - 1; k >= 0; k--)
+        {
+            copy(remainingVotes.begin() + (k + 1) * numberOfClasses, remainingVotes.begin() + (k + 2) * numberOfClasses,
+                 remainingVotes.begin() + k * numberOfClasses);
+            copy(remainingNegativeVotes.begin() + (k + 1) * numberOfClasses, remainingNegativeVotes.begin() + (k + 2) * numberOfClasses,
+                 remainingNegativeVotes.begin() + k * numberOfClasses);
+            double confidence = ruleVector[votingOrder[k]]->getConfidenceDegree();
+            if (confidence > 0)
+                remainingVotes[k * numberOfClasses + votingClasses[k]] += confidence;
+            else
+                remainingNegativeVotes[k * numberOfClasses + votingClasses[k]] += confidence;
+        }
+    //sums of the same confidence degrees in different orders differ at most by this value
+    votingTolerance = 4 * (numberOfRules + 2) * numeric_limits<double>::epsilon() * sumOfConfidences;
+    votingPrepared = true;
+}
+
+/**
+ * Classifies an example by the rules in the voting order prepared by prepareVoting. The voting stops early
+ * if the leading class wins regardless of the rules not checked yet; otherwise the covering rules vote
+ * as in classifyExample, so the prediction is always the same.
+ * @param example example to be classified
+ * @param sums buffer for the sums of confidence degrees of the classes
+ * @param covering buffer for the indices of the covering rules
+ * @return predicted class value
+ */
+double RuleClassifier::vote(Example& example, vector<double>& sums, vector<int>& covering) const
+{
+    fill(sums.begin(), sums.end(), 0.0);
+    covering.clear();
+    int numberOfRules = votingOrder.size();
+    int leader = -1;
+    for (int k = 0; k < numberOfRules; k++)
+    {
+        if (leader != -1 && isDecided(k, leader, sums))
+            break;
+        const Rule* rule = ruleVector[votingOrder[k]];
+        if (!rule->covers(example))
+            continue;
+        covering.push_back(votingOrder[k]);
+        int decisionClass = votingClasses[k];
+        sums[decisionClass] += rule->getConfidenceDegree();
+        if (earlyExit && (leader == -1 || sums[decisionClass] > sums[leader]))
+            leader = decisionClass;
+    }
+    //the votes are counted again in the order of the rule list, as the sums depend on the order of additions
+    sort(covering.begin(), covering.end());
+    vector<const Rule*> coveringRules(covering.size());
+    for (size_t i = 0; i < covering.size(); i++)
+        coveringRules[i] = ruleVector[covering[i]];
+    return classify(coveringRules);
+}
+
+/**
+ * Checks if the leading class wins the voting whatever the rules from the given position on cover.
+ * Classes which got no votes yet are treated as if they had zero sums.
+ * @param position position in the voting order of the first rule not checked yet
+ * @param leader index of the leading class
+ * @param sums sums of confidence degrees of the covering rules checked so far
+ * @return true if no other class can get at least the sum of the leading class
+ */
+bool RuleClassifier::isDecided(int position, int leader, const vector<double>& sums) const
+{
+    const double* remaining = &remainingVotes[position * numberOfClasses];
+    double leaderSum = sums[leader] + remainingNegativeVotes[position * numberOfClasses + leader] - votingTolerance;
+    for (int c = 0; c < numberOfClasses; c++)
+        if (c != leader && sums[c] + remaining[c] >= leaderSum)
+            return false;
+    return true;
+}
+
 /**
  * Metoda generująca macierz pomyłek dla zadanego zbioru testowego.
  * @param testSet testowy zbiór przykładów.
@@ -81,31 +245,15 @@ ConfusionMatrix RuleClassifier::generateConfusionMatrix(SetOfExamples& testSet,
 	unsigned int numOfExamples = testSet.size();
 	double actualClass, predictedClass;
         if(preds.size() != numOfExamples)   //if preds is empty, fill it with predictions
+            preds = classifyExamples(testSet);
+        for(unsigned int i = 0; i < numOfExamples; i++)
         {
-            preds.clear();
-            preds.resize(numOfExamples);
-            for(unsigned int i = 0; i < numOfExamples; i++)
-            {
-                actualClass = testSet[i].getDecisionAttribute();
-                predictedClass = classifyExample(testSet[i]);
-                if(predictedClass == predictedClass)
-                    confusionMatrix[actualClass][predictedClass]++;
-                else
-                    confusionMatrix.getUnclassified()[actualClass]++;
-                preds[i] = predictedClass;
-            }
-        }
-        else    //using preds instead of classifying
-        {
-            for(unsigned int i = 0; i < numOfExamples; i++)
-            {
-                actualClass = testSet[i].getDecisionAttribute();
-                predictedClass = preds[i];
-                if(predictedClass == predictedClass)
-                    confusionMatrix[actualClass][predictedClass]++;
-                else
-                    confusionMatrix.getUnclassified()[actualClass]++;
-            }
+            actualClass = testSet[i].getDecisionAttribute();
+            predictedClass = preds[i];
+            if(predictedClass == predictedClass)
+                confusionMatrix[actualClass][predictedClass]++;
+            else
+                confusionMatrix.getUnclassified()[actualClass]++;
         }
 
 	return confusionMatrix;
@@ -124,31 +272,15 @@ ConfusionMatrix RuleClassifier::generateConfusionMatrixWithWeights(SetOfExamples
 	unsigned int numOfExamples = testSet.size();
 	double actualClass, predictedClass;
         if(preds.size() != numOfExamples)   //if preds is empty, fill it with predictions
+            preds = classifyExamples(testSet);
+        for(unsigned int i = 0; i < numOfExamples; i++)
         {
-            preds.clear();
-            preds.resize(numOfExamples);
-            for(unsigned int i = 0; i < numOfExamples; i++)
-            {
-                actualClass = testSet[i].getDecisionAttribute();
-                predictedClass = classifyExample(testSet[i]);
-                if(predictedClass == predictedClass)
-                    confusionMatrix[actualClass][predictedClass] += testSet[i].getWeight();
-                else
-                    confusionMatrix.getUnclassified()[actualClass] += testSet[i].getWeight();
-                preds[i] = predictedClass;
-            }
-        }
-        else    //using preds instead of classifying
-        {
-            for(unsigned int i = 0; i < numOfExamples; i++)
-            {
-                actualClass = testSet[i].getDecisionAttribute();
-                predictedClass = preds[i];
-                if(predictedClass == predictedClass)
-                    confusionMatrix[actualClass][predictedClass] += testSet[i].getWeight();
-                else
-                    confusionMatrix.getUnclassified()[actualClass] += testSet[i].getWeight();
-            }
+            actualClass = testSet[i].getDecisionAttribute();
+            predictedClass = preds[i];
+            if(predictedClass == predictedClass)
+                confusionMatrix[actualClass][predictedClass] += testSet[i].getWeight();
+            else
+                confusionMatrix.getUnclassified()[actualClass] += testSet[i].getWeight();
         }
 
 	return confusionMatrix;
@@ -230,18 +362,40 @@ double RuleClassifier::getCoverage(vector<double>& predictions, SetOfExamples& e
  * Adds rule to classifier
  * @param newRule rule to be added to classifier
  */
-void RuleClassifier::addRule(Rule& newRule)
+void RuleClassifier::addRule(const Rule& newRule)
 {
 	rules.push_back(newRule);
+	votingPrepared = false;
+}
+
+/**
+ * Moves rule to classifier
+ * @param newRule rule to be moved to classifier
+ */
+void RuleClassifier::addRule(Rule&& newRule)
+{
+	rules.push_back(std::move(newRule));
+	votingPrepared = false;
 }
 
 /**
  * Adds list of rules to classfier
  * @param newRules list of rule to be added to classfier
  */
-void RuleClassifier::addRules(list<Rule>& newRules)
+void RuleClassifier::addRules(const list<Rule>& newRules)
 {
     rules.insert(rules.end(), newRules.begin(), newRules.end());
+    votingPrepared = false;
+}
+
+/**
+ * Moves list of rules to classfier
+ * @param newRules list of rule to be moved to classfier; it is empty after the call
+ */
+void RuleClassifier::addRules(list<Rule>&& newRules)
+{
+    rules.splice(rules.end(), newRules);
+    votingPrepared = false;
 }
 
 /**
@@ -293,31 +447,55 @@ vector<string> RuleClassifier::toVectorOfStrings(DataSet& ds)
 /**
  * Computes the most important statistics of the rule set
  * @param examples set of examples which the statistics will be computed on
+ * @param trainingSet true if the rules were generated on the examples; then results of the evaluation
+ * recorded by the induction are used instead of evaluating the rules again
  * @return object of the RuleSetStats class which contains values of computed statistics
  */
-RuleSetStats RuleClassifier::getRuleSetStats(SetOfExamples& examples)
+RuleSetStats RuleClassifier::getRuleSetStats(SetOfExamples& examples, bool trainingSet)
 {
+    AllocationPhase phase(AllocationCounter::STATS);
     RuleSetStats stats;
     Coverage coverage;
     Precision precision;
     Pvalue pvalue;
-    RuleEvaluationResult rer;
     int nconds = 0;
     list<Rule>::iterator it;
     list<ElementaryCondition>::iterator itCond;
     vector<list<ElementaryCondition> >::iterator itVec;
     stats.warning = false;
-    for (it = rules.begin(); it != rules.end(); it++)
+
+    //rules which have to be evaluated are evaluated in parallel
+    vector<RuleEvaluationResult> results(rules.size());
+    vector<Rule*> toEvaluate;
+    vector<int> toEvaluateIndices;
+    int i = 0;
+    for (it = rules.begin(); it != rules.end(); it++, i++)
+    {
+        if (trainingSet && it->isEvaluated())
+            results[i] = it->getEvaluationResult();
+        else
+        {
+            toEvaluate.push_back(&*it);
+            toEvaluateIndices.push_back(i);
+        }
+    }
+    int toEvaluateCount = toEvaluate.size();
+    #pragma omp parallel for schedule(dynamic)
+    for (int j = 0; j < toEvaluateCount; j++)
+        results[toEvaluateIndices[j]] = RuleQualityMeasure::EvaluateRule(examples, *toEvaluate[j]);
+
+    i = 0;
+    for (it = rules.begin(); it != rules.end(); it++, i++)
     {
         nconds = 0;
         for (itVec = it->getConditions().begin(); itVec != it->getConditions().end(); itVec++)
         	if(itVec->size() > 0)
         		nconds++;
-        rer  = RuleQualityMeasure::EvaluateRule(examples, *it);
         stats.condCounts.push_back(nconds);
-        stats.precs.push_back(precision.EvaluateRuleQualityFromResult(rer));
-        stats.covs.push_back(coverage.EvaluateRuleQualityFromResult(rer));
-        stats.pvalues.push_back(pvalue.ComputePvalue(rer, stats.warning));
+        stats.precs.push_back(precision.EvaluateRuleQualityFromResult(results[i]));
+        stats.covs.push_back(coverage.EvaluateRuleQualityFromResult(results[i]));
+        stats.pvalues.push_back(pvalue.ComputePvalue(results[i], stats.warning));
     }
+    stats.results.swap(results);
     return stats;
 }
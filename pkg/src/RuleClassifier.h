@@ -10,6 +10,7 @@
 #include "Operator.h"
 #include "ConfusionMatrix.h"
 #include "SequentialCovering.h"
+#include "MemoryPool.h"
 #include <map>
 #include <vector>
 #include <stdlib.h>
@@ -28,10 +29,15 @@ class RuleSetStats;
 class RuleClassifier
 {
 public:
-    RuleClassifier() {}
-    RuleClassifier(std::list<Rule>& rules): rules(rules) {}
-    double classifyExample(Example& example);
-    std::vector<double> classifyExamples(SetOfExamples& examples);
+    RuleClassifier() { prepareVoting(); }
+    RuleClassifier(const std::list<Rule>& rules): rules(rules) { prepareVoting(); }
+    RuleClassifier(std::list<Rule>&& rules): rules(std::move(rules)) { prepareVoting(); }
+    RuleClassifier(const RuleClassifier& orig): rules(orig.rules) { prepareVoting(); }
+    RuleClassifier(RuleClassifier&& orig): rules(std::move(orig.rules)) { prepareVoting(); orig.prepareVoting(); }
+    RuleClassifier& operator=(const RuleClassifier& orig);
+    RuleClassifier& operator=(RuleClassifier&& orig);
+    double classifyExample(Example& example) const;
+    std::vector<double> classifyExamples(SetOfExamples& examples) const;
     ConfusionMatrix generateConfusionMatrix(SetOfExamples& testSet, std::vector<double>& preds);
     ConfusionMatrix generateConfusionMatrixWithWeights(SetOfExamples& testSet, std::vector<double>& preds);
     double evaluateAccuracy(ConfusionMatrix& cm);
@@ -43,18 +49,37 @@ public:
     double getCoverage(std::vector<double>& predictions);
     double getCoverage(std::vector<double>& predictions, SetOfExamples& examples);
     void removeRules();
-    void addRule(Rule& newRule);
-    void addRules(std::list<Rule>& newRules);
+    void addRule(const Rule& newRule);
+    void addRule(Rule&& newRule);
+    void addRules(const std::list<Rule>& newRules);
+    void addRules(std::list<Rule>&& newRules);
     std::list<Rule> getCoveringRules(Example& example);
-    RuleSetStats getRuleSetStats(SetOfExamples& examples);
+    RuleSetStats getRuleSetStats(SetOfExamples& examples, bool trainingSet = false);
     std::string toString();
     std::string toString(DataSet& ds);
     std::vector<std::string> toVectorOfStrings(DataSet& ds);
-    void setRules(std::list<Rule>& rules) { removeRules(); this->rules = rules; }
-    std::list<Rule>& getRules() { return rules; }
+    void setRules(const std::list<Rule>& rules) { this->rules = rules; prepareVoting(); }
+    void setRules(std::list<Rule>&& rules) { this->rules = std::move(rules); prepareVoting(); }
+    /** the rules may be changed through the reference, so classifyExamples votes without the prepared order until prepareVoting is called*/
+    std::list<Rule>& getRules() { votingPrepared = false; return rules; }
+    void prepareVoting();
+    static double classify(std::vector<const Rule*>& coveringRules);
 private:
-    double resolveConflict(std::list<Rule>&);
+    static double resolveConflict(std::vector<const Rule*>& coveringRules);
+    double vote(Example& example, std::vector<double>& sums, std::vector<int>& covering) const;
+    bool isDecided(int position, int leader, const std::vector<double>& sums) const;
+
     std::list<Rule> rules;
+    //voting data prepared whenever the rules are set (read only by the classification, so it may be shared)
+    bool votingPrepared;                    /**< false if the rules may have changed since the voting was prepared*/
+    std::vector<const Rule*> ruleVector;    /**< rules in the order of the list*/
+    std::vector<int> votingOrder;           /**< indices of the rules by descending confidence degree*/
+    std::vector<int> votingClasses;         /**< index of the decision class of every rule in the voting order*/
+    std::vector<double> remainingVotes;     /**< sums of positive confidence degrees of the rules from every position on, per class*/
+    std::vector<double> remainingNegativeVotes; /**< sums of negative confidence degrees of the rules from every position on, per class*/
+    int numberOfClasses;
+    double votingTolerance;                 /**< bound of the rounding error of the sums of confidence degrees*/
+    bool earlyExit;                         /**< false if some confidence degree is not finite*/
 };
 
 /**
@@ -68,6 +93,7 @@ public:
     std::vector<double> precs;         /**< rule precisions*/
     std::vector<double> covs;          /**< rule coverages*/
     std::vector<double> pvalues;          /**< p-values*/
+    std::vector<RuleEvaluationResult> results;   /**< numbers of examples covered by rules*/
     bool warning;
 };
 
@@ -0,0 +1,54 @@
+#ifndef RULEEVALUATIONRESULT_H
+#define	RULEEVALUATIONRESULT_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * Contains result of the evaluation of the rule
+ */
+class RuleEvaluationResult {
+public:
+
+    RuleEvaluationResult() : P(0), p(0), N(0), n(0) {
+    }
+
+    RuleEvaluationResult(double P, double p, double N, double n) : P(P), p(p), N(N), n(n) {
+    }
+    double P;  /**< positives*/
+    double p;  /**< true positives*/
+    double N;  /**< negatives*/
+    double n;  /**< false negatives*/
+};
+
+/**
+ * Contains results of the evaluation of many rules (or conditions) stored as separate arrays of P, p, N and n,
+ * so they can be evaluated by one call of the rule quality measure
+ */
+class RuleEvaluationResults {
+public:
+    void push_back(const RuleEvaluationResult& r) {
+        P.push_back(r.P);
+        p.push_back(r.p);
+        N.push_back(r.N);
+        n.push_back(r.n);
+    }
+    RuleEvaluationResult get(std::size_t i) const {
+        return RuleEvaluationResult(P[i], p[i], N[i], n[i]);
+    }
+    std::size_t size() const {
+        return p.size();
+    }
+    void clear() {
+        P.clear();
+        p.clear();
+        N.clear();
+        n.clear();
+    }
+    std::vector<double> P;  /**< positives*/
+    std::vector<double> p;  /**< true positives*/
+    std::vector<double> N;  /**< negatives*/
+    std::vector<double> n;  /**< false negatives*/
+};
+
+#endif	/* RULEEVALUATIONRESULT_H */
@@ -1,33 +1,113 @@
 #include "RuleQualityMeasure.h"
+#include "ExampleWeights.h"
+#include "UnitWeights.h"
+#include <map>
 
 using namespace std;
 
+namespace
+{
+const int REANCHOR_INTERVAL = 256;      /**< every that many terms the current term is computed exactly again*/
+const double RESCALE_THRESHOLD = 1e200;
+const size_t MAX_LOG_FACTORIALS = 1 << 20;
+}
+
+namespace
+{
 /**
- * Generates RuleEvaluationResult object for the rule based on the set of examples
- * @param ds set of examples
- * @param rule evaluated rule
- * @return RuleEvaluationResult object
+ * Counting kernels of the evaluation; Weights is ExampleWeights or, for sets without weights, UnitWeights
  */
-RuleEvaluationResult RuleQualityMeasure::EvaluateRule(SetOfExamples& dataset, Rule& rule)
+template <class Weights>
+RuleEvaluationResult evaluateRule(SetOfExamples& dataset, Rule& rule)
 {
-    RuleEvaluationResult result;
+    Weights weight(dataset);
+    typename Weights::Count P = 0, p = 0, N = 0, n = 0;
     int size = dataset.size();
     for (int i = 0; i < size; i++)
     {
         if (dataset[i].getDecisionAttribute() == rule.getDecisionClass()) //if positive
         {
-            result.P += dataset[i].getWeight();
+            P += weight(i);
             if (rule.covers(dataset[i]))
-                result.p += dataset[i].getWeight();
+                p += weight(i);
         }
         else //if negative
         {
-            result.N += dataset[i].getWeight();
+            N += weight(i);
             if (rule.covers(dataset[i]))
-                result.n += dataset[i].getWeight();
+                n += weight(i);
+        }
+    }
+    return RuleEvaluationResult(P, p, N, n);
+}
+
+template <class Weights>
+RuleEvaluationResult evaluateCondition(SetOfExamples& dataset, ElementaryCondition& cond, double decClass)
+{
+    Weights weight(dataset);
+    typename Weights::Count P = 0, p = 0, N = 0, n = 0;
+    int size = dataset.size();
+    int attIndex = cond.getAttributeIndex();
+    for (int i = 0; i < size; i++)
+    {
+        if (dataset[i].getDecisionAttribute() == decClass) //if positive
+        {
+            P += weight(i);
+            if (cond.isSatisfied(dataset[i].getAttribute(attIndex)))
+                p += weight(i);
+        }
+        else //if negative
+        {
+            N += weight(i);
+            if (cond.isSatisfied(dataset[i].getAttribute(attIndex)))
+                n += weight(i);
         }
     }
-    return result;
+    return RuleEvaluationResult(P, p, N, n);
+}
+
+template <class Weights>
+RuleEvaluationResult evaluateClass(SetOfExamples& dataset, double decClass)
+{
+    Weights weight(dataset);
+    typename Weights::Count P = 0, N = 0;
+    int size = dataset.size();
+    for (int i = 0; i < size; i++)
+    {
+        if (dataset[i].getDecisionAttribute() == decClass)
+            P += weight(i);
+        else
+            N += weight(i);
+    }
+    return RuleEvaluationResult(P, 0, N, 0);
+}
+
+template <class Weights>
+RuleEvaluationResult evaluateCoveredExamples(SetOfExamples& covered, double decClass, RuleEvaluationResult classResult)
+{
+    Weights weight(covered);
+    typename Weights::Count p = 0, n = 0;
+    int size = covered.size();
+    for (int i = 0; i < size; i++)
+    {
+        if (covered[i].getDecisionAttribute() == decClass)
+            p += weight(i);
+        else
+            n += weight(i);
+    }
+    return RuleEvaluationResult(classResult.P, p, classResult.N, n);
+}
+}
+
+/**
+ * Generates RuleEvaluationResult object for the rule based on the set of examples
+ * @param ds set of examples
+ * @param rule evaluated rule
+ * @return RuleEvaluationResult object
+ */
+RuleEvaluationResult RuleQualityMeasure::EvaluateRule(SetOfExamples& dataset, Rule& rule)
+{
+    return dataset.hasUnitWeights() ? evaluateRule<UnitWeights>(dataset, rule) : evaluateRule<ExampleWeights>(dataset, rule);
 }
 
 /**
@@ -39,25 +119,139 @@ RuleEvaluationResult RuleQualityMeasure::EvaluateRule(SetOfExamples& dataset, Ru
  */
 RuleEvaluationResult RuleQualityMeasure::EvaluateCondition(SetOfExamples& dataset, ElementaryCondition& cond, double decClass)
 {
-    RuleEvaluationResult result;
-    int size = dataset.size();
-    int attIndex = cond.getAttributeIndex();
-    for (int i = 0; i < size; i++)
+    return dataset.hasUnitWeights() ? evaluateCondition<UnitWeights>(dataset, cond, decClass)
+                                    : evaluateCondition<ExampleWeights>(dataset, cond, decClass);
+}
+
+/**
+ * Computes weights of positive and negative examples in the set of examples
+ * (in the same order of summation as EvaluateRule does)
+ * @param ds set of examples
+ * @param decClass positive class value
+ * @return RuleEvaluationResult object with P and N set
+ */
+RuleEvaluationResult RuleQualityMeasure::EvaluateClass(SetOfExamples& dataset, double decClass)
+{
+    return dataset.hasUnitWeights() ? evaluateClass<UnitWeights>(dataset, decClass) : evaluateClass<ExampleWeights>(dataset, decClass);
+}
+
+/**
+ * Generates RuleEvaluationResult object for the rule from the set of examples covered by it.
+ * Gives the same result as EvaluateRule if the covered examples are in the same order as in the whole set.
+ * @param covered set of examples covered by the rule
+ * @param decClass positive class value
+ * @param classResult result of EvaluateClass for the whole set of examples
+ * @return RuleEvaluationResult object
+ */
+RuleEvaluationResult RuleQualityMeasure::EvaluateCoveredExamples(SetOfExamples& covered, double decClass, RuleEvaluationResult classResult)
+{
+    return covered.hasUnitWeights() ? evaluateCoveredExamples<UnitWeights>(covered, decClass, classResult)
+                                    : evaluateCoveredExamples<ExampleWeights>(covered, decClass, classResult);
+}
+
+namespace
+{
+/**
+ * Sums of weights of examples of every decision class (values of the decision attribute are
+ * indices of its levels). Histograms for a few classes are kept on the stack, so entropy
+ * is computed without allocating memory. If a value of the decision attribute is not an index
+ * of a level, the histogram switches to counting the classes in a map.
+ */
+class ClassHistogram
+{
+public:
+    ClassHistogram(int classCount) : classCount(classCount), total(0)
     {
-        if (dataset[i].getDecisionAttribute() == decClass) //if positive
+        if (classCount > LOCAL_CLASSES)
         {
-            result.P += dataset[i].getWeight();
-            if (cond.isSatisfied(dataset[i].getAttribute(attIndex)))
-                result.p += dataset[i].getWeight();
+            heapWeights.assign(classCount, 0);
+            heapCounts.assign(classCount, 0);
+            weights = &heapWeights[0];
+            counts = &heapCounts[0];
         }
-        else //if negative
+        else
         {
-            result.N += dataset[i].getWeight();
-            if (cond.isSatisfied(dataset[i].getAttribute(attIndex)))
-                result.n += dataset[i].getWeight();
+            weights = localWeights;
+            counts = localCounts;
+            for (int i = 0; i < classCount; i++)
+            {
+                weights[i] = 0;
+                counts[i] = 0;
+            }
         }
     }
-    return result;
+
+    void add(double decClass, double weight)
+    {
+        int index = (int)decClass;
+        if (others.empty() && index == decClass && index >= 0 && index < classCount)
+        {
+            weights[index] += weight;
+            counts[index]++;
+        }
+        else
+            addOther(decClass, weight);
+        total += weight;
+    }
+
+    double getSumOfWeights() const { return total; }
+
+    /**
+     * Computes entropy of the distribution of classes; classes are taken in ascending order
+     * @return value of entropy
+     */
+    double entropy() const
+    {
+        double sum = 0, p;
+        if (!others.empty())
+        {
+            for (map<double, double>::const_iterator it = others.begin(); it != others.end(); it++)
+            {
+                p = it->second / total;
+                if (p != 0)
+                    sum += p * RuleQualityMeasure::Log2(p);
+            }
+            return -sum;
+        }
+        for (int i = 0; i < classCount; i++)
+        {
+            if (counts[i] == 0)
+                continue;
+            p = weights[i] / total;
+            if (p != 0)
+                sum += p * RuleQualityMeasure::Log2(p);
+        }
+        return -sum;
+    }
+private:
+    ClassHistogram(const ClassHistogram&);
+    ClassHistogram& operator=(const ClassHistogram&);
+
+    void addOther(double decClass, double weight)
+    {
+        if (others.empty())     //the classes counted so far are moved to the map
+            for (int i = 0; i < classCount; i++)
+                if (counts[i] > 0)
+                    others[i] = weights[i];
+        others[decClass] += weight;
+    }
+
+    static const int LOCAL_CLASSES = 16;
+    int classCount;
+    double total;
+    double* weights;
+    int* counts;
+    double localWeights[LOCAL_CLASSES];
+    int localCounts[LOCAL_CLASSES];
+    vector<double> heapWeights;
+    vector<int> heapCounts;
+    map<double, double> others;     /**< sums of weights of all the classes after a value out of the levels*/
+};
+
+int getNumberOfClasses(SetOfExamples& examples)
+{
+    return examples.getDataSet().getDecisionAttribute().getLevels().size();
+}
 }
 
 /**
@@ -67,23 +261,11 @@ RuleEvaluationResult RuleQualityMeasure::EvaluateCondition(SetOfExamples& datase
  */
 double NegConditionalEntropy::Entropy(SetOfExamples& examples)
 {
-	set<double> classes;
-	int size = examples.size();
-    double sumOfWeights = examples.getSumOfWeights();
-	for(int i = 0; i < size; i++)	//it's probably wrong because there are only two classes - positive and negative
-		classes.insert(examples[i].getDecisionAttribute());
-
-    double sum = 0, p;
-    set<double>::iterator it;
-    for(it = classes.begin(); it != classes.end(); it++)
-    {
-        //p = (double)examples.getExamplesForDecAtt(*it).size() / size;
-        p = examples.getExamplesForDecAtt(*it).getSumOfWeights() / sumOfWeights;
-        if(p != 0)
-            sum += p * Log2(p);
-        //sum += p * log2(p);
-    }
-    return -sum;
+    ClassHistogram histogram(getNumberOfClasses(examples));
+    int size = examples.size();
+    for (int i = 0; i < size; i++)
+        histogram.add(examples[i].getDecisionAttribute(), examples.getWeight(i));
+    return histogram.entropy();
 }
 
 /**
@@ -94,19 +276,20 @@ double NegConditionalEntropy::Entropy(SetOfExamples& examples)
  */
 double NegConditionalEntropy::EvaluateRuleQuality(SetOfExamples& ds, Rule& rule)
 {
-    SetOfExamples s1(ds.getDataSet());
-    SetOfExamples s2(ds.getDataSet());
+    ClassHistogram covered(getNumberOfClasses(ds));
+    ClassHistogram uncovered(getNumberOfClasses(ds));
+    double sumOfWeights = 0;
     int size = ds.size();
     for(int i = 0; i < size; i++)
     {
+        sumOfWeights += ds.getWeight(i);
         if(rule.covers(ds[i]))
-            s1.addExample(ds, i);
+            covered.add(ds[i].getDecisionAttribute(), ds.getWeight(i));
         else
-            s2.addExample(ds, i);
+            uncovered.add(ds[i].getDecisionAttribute(), ds.getWeight(i));
     }
-    double sumOfWeights = ds.getSumOfWeights();
-    //double result = ((double)s1.size() / (double)size) * Entropy(s1) + ((double)s2.size() / (double)size) * Entropy(s2);
-    double result = (s1.getSumOfWeights() / sumOfWeights) * Entropy(s1) + (s2.getSumOfWeights() / sumOfWeights) * Entropy(s2);
+    double result = (covered.getSumOfWeights() / sumOfWeights) * covered.entropy()
+            + (uncovered.getSumOfWeights() / sumOfWeights) * uncovered.entropy();
     return -result;
 }
 
@@ -117,22 +300,23 @@ double NegConditionalEntropy::EvaluateRuleQuality(SetOfExamples& ds, Rule& rule)
  * @param decClass positive class value
  * @return negated value of conditional entropy
  */
-double NegConditionalEntropy::EvaluateConditionQuality(SetOfExamples& ds, ElementaryCondition& cond, double decClass)
+double NegConditionalEntropy::EvaluateConditionQuality(SetOfExamples& ds, ElementaryCondition& cond, double /*decClass*/)
 {
-    SetOfExamples s1(ds.getDataSet());
-    SetOfExamples s2(ds.getDataSet());
+    ClassHistogram satisfied(getNumberOfClasses(ds));
+    ClassHistogram unsatisfied(getNumberOfClasses(ds));
+    double sumOfWeights = 0;
     int attIndex = cond.getAttributeIndex();
     int size = ds.size();
     for(int i = 0; i < size; i++)
     {
+        sumOfWeights += ds.getWeight(i);
         if(cond.isSatisfied(ds[i].getAttribute(attIndex)))
-            s1.addExample(ds, i);
+            satisfied.add(ds[i].getDecisionAttribute(), ds.getWeight(i));
         else
-            s2.addExample(ds, i);
+            unsatisfied.add(ds[i].getDecisionAttribute(), ds.getWeight(i));
     }
-    double sumOfWeights = ds.getSumOfWeights();
-    //double result = ((double)s1.size() / (double)size) * Entropy(s1) + ((double)s2.size() / (double)size) * Entropy(s2);
-    double result = (s1.getSumOfWeights() / sumOfWeights) * Entropy(s1) + (s2.getSumOfWeights() / sumOfWeights) * Entropy(s2);
+    double result = (satisfied.getSumOfWeights() / sumOfWeights) * satisfied.entropy()
+            + (unsatisfied.getSumOfWeights() / sumOfWeights) * unsatisfied.entropy();
     return -result;
 }
 
@@ -155,3 +339,73 @@ double NegConditionalEntropy::ComputeQualityForTwoGroups(double p1, double n1, d
 
 	return -(pn1 * (-entropy1) + pn2 * (-entropy2)) / sumOfWeights;
 }
+
+/**
+ * Computes p-value of the rule, i.e. the sum of probabilities of the hypergeometric distribution
+ * for the rules covering more positives (and fewer negatives) than the evaluated one.
+ * @param r result of the evaluation of the rule
+ * @param warning set to true if the result is computed for weighted examples
+ * @return p-value
+ */
+double Pvalue::ComputePvalue(RuleEvaluationResult r, bool& warning)
+{
+    int upto = !(r.P - r.p < r.n) ? r.n : r.P - r.p;
+    if(r.P > (int)r.P || r.p > (int)r.p || r.N > (int)r.N || r.n > (int)r.n)
+        warning = true;
+    if (upto <= 0)
+        return 0;
+    integral = r.P == floor(r.P) && r.p == floor(r.p) && r.N == floor(r.N) && r.n == floor(r.n);
+
+    //terms are kept divided by exp(scale) so neither the first term nor the sum underflows or overflows
+    double scale = logProb(r.p, r.n, r.P, r.N);
+    double term = 1;
+    double sum = 0;
+    for (int k = 0; k < upto; k++)
+    {
+        sum += term;
+        if (k + 1 == upto)
+            break;
+        //T(k+1) / T(k); the ratio decreases with k
+        double ratio = ((r.P - r.p - k) / (r.p + k + 1)) * ((r.n - k) / (r.N - r.n + k + 1));
+        term *= ratio;
+        if ((k + 1) % REANCHOR_INTERVAL == 0)
+            term = exp(logProb(r.p + k + 1, r.n - k - 1, r.P, r.N) - scale);
+        //the remaining terms are bounded by the geometric series with the current ratio
+        if (ratio < 1 && term / (1 - ratio) <= sum * numeric_limits<double>::epsilon() / 16)
+            break;
+        if (term > RESCALE_THRESHOLD)
+        {
+            sum /= RESCALE_THRESHOLD;
+            term /= RESCALE_THRESHOLD;
+            scale += log(RESCALE_THRESHOLD);
+        }
+    }
+    return sum * exp(scale);
+}
+
+/**
+ * Computes logarithm of the probability of the hypergeometric distribution
+ */
+double Pvalue::logProb(double p, double n, double P, double N)
+{
+    return logFactorial(p + n) + logFactorial(P + N - p - n) + logFactorial(P) + logFactorial(N)
+            - logFactorial(n) - logFactorial(p) - logFactorial(N - n) - logFactorial(P - p) - logFactorial(P + N);
+}
+
+/**
+ * Computes log(x!); uses table of values for integer arguments of unweighted rules
+ */
+double Pvalue::logFactorial(double x)
+{
+    if (!integral || x < 0 || x >= MAX_LOG_FACTORIALS)
+        return lgamma(x + 1);
+    size_t index = (size_t)x;
+    if (index >= logFactorials.size())
+    {
+        size_t k = logFactorials.size();
+        logFactorials.resize(index + 1);
+        for (; k <= index; k++)
+            logFactorials[k] = lgamma(k + 1.0);
+    }
+    return logFactorials[index];
+}
@@ -3,24 +3,10 @@
 #include "Rule.h"
 #include "SetOfExamples.h"
 #include "Attribute.h"
+#include "RuleEvaluationResult.h"
 #include <cmath>
-
-/**
- * Contains result of the evaluation of the rule
- */
-class RuleEvaluationResult {
-public:
-
-    RuleEvaluationResult() : P(0), p(0), N(0), n(0) {
-    }
-
-    RuleEvaluationResult(double P, double p, double N, double n) : P(P), p(p), N(N), n(n) {
-    }
-    double P;  /**< positives*/
-    double p;  /**< true positives*/
-    double N;  /**< negatives*/
-    double n;  /**< false negatives*/
-};
+#include <vector>
+#include <limits>
 
 /**
  * Base class for rule quality measures
@@ -30,12 +16,24 @@ public:
     virtual ~RuleQualityMeasure() {};
     static RuleEvaluationResult EvaluateRule(SetOfExamples&, Rule&);
     static RuleEvaluationResult EvaluateCondition(SetOfExamples& ds, ElementaryCondition& cond, double decClass);
+    static RuleEvaluationResult EvaluateClass(SetOfExamples& ds, double decClass);
+    static RuleEvaluationResult EvaluateCoveredExamples(SetOfExamples& covered, double decClass, RuleEvaluationResult classResult);
     /**
      * Evaluates rule quality based on RuleEvaluationResult object
      * @param r RuleEvaluationResult object
      * @return evaluation of rule quality
      */
     virtual double EvaluateRuleQualityFromResult(RuleEvaluationResult r){return std::numeric_limits<double>::quiet_NaN();}
+    /**
+     * Evaluates rule quality for many RuleEvaluationResult objects
+     * @param r results of the evaluation of rules
+     * @param qualities vector to be filled with evaluations of rule quality (one per result)
+     */
+    virtual void EvaluateRuleQualityFromResults(const RuleEvaluationResults& r, std::vector<double>& qualities) {
+        qualities.resize(r.size());
+        for (std::size_t i = 0; i < r.size(); i++)
+            qualities[i] = EvaluateRuleQualityFromResult(r.get(i));
+    }
     /**
      * Evaluates quality of the rule on set of examples
      * @param ds set of examples
@@ -55,18 +53,57 @@ public:
     virtual double EvaluateConditionQuality(SetOfExamples& ds, ElementaryCondition& cond, double decClass) {
         return EvaluateRuleQualityFromResult(EvaluateCondition(ds, cond, decClass));
     }
+    /**
+     * Gives an upper bound of the quality of rules covering at most r.p positive and at least r.n negative examples
+     * @param r RuleEvaluationResult object
+     * @return the bound, infinity if the measure does not give bounds
+     */
+    virtual double EvaluateOptimisticBound(RuleEvaluationResult) { return std::numeric_limits<double>::infinity(); }
+    /**
+     * @return true if EvaluateOptimisticBound gives finite bounds
+     */
+    virtual bool HasOptimisticBound() { return false; }
     //virtual double EvaluateRuleQuality(SetOfExamples&, ElementaryCondition, double);
     static double Log2(double n) { return log(n) / log(2.0); } //for windows c++ compiler
 };
 
-class Precision : public RuleQualityMeasure {
+/**
+ * Base class for measures computed only from RuleEvaluationResult; evaluates many results
+ * without a virtual call for every one of them
+ */
+template <class Measure>
+class BatchRuleQualityMeasure : public RuleQualityMeasure {
+public:
+    void EvaluateRuleQualityFromResults(const RuleEvaluationResults& r, std::vector<double>& qualities) {
+        Measure& measure = static_cast<Measure&>(*this);
+        qualities.resize(r.size());
+        for (std::size_t i = 0; i < r.size(); i++)
+            qualities[i] = measure.Measure::EvaluateRuleQualityFromResult(RuleEvaluationResult(r.P[i], r.p[i], r.N[i], r.n[i]));
+    }
+};
+
+/**
+ * Base class for measures which do not decrease with p and do not increase with n (for fixed P and N),
+ * so the quality of a rule bounds the quality of every rule covering its subset of positive and
+ * a superset of its negative examples
+ */
+template <class Measure>
+class MonotoneRuleQualityMeasure : public BatchRuleQualityMeasure<Measure> {
+public:
+    double EvaluateOptimisticBound(RuleEvaluationResult r) {
+        return static_cast<Measure&>(*this).Measure::EvaluateRuleQualityFromResult(r);
+    }
+    bool HasOptimisticBound() { return true; }
+};
+
+class Precision : public MonotoneRuleQualityMeasure<Precision> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return r.p / (r.p + r.n);
     }
 };
 
-class Coverage : public RuleQualityMeasure {
+class Coverage : public MonotoneRuleQualityMeasure<Coverage> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return r.p / r.P;
@@ -74,56 +111,56 @@ public:
 };
 
 
-class RSS : public RuleQualityMeasure {
+class RSS : public MonotoneRuleQualityMeasure<RSS> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return r.p / r.P - r.n / r.N;
     }
 };
 
-class TwoMeasure : public RuleQualityMeasure {
+class TwoMeasure : public MonotoneRuleQualityMeasure<TwoMeasure> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return r.p / (r.p + r.n + 2);
     }
 };
 
-class Lift : public RuleQualityMeasure {
+class Lift : public MonotoneRuleQualityMeasure<Lift> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return (r.p + 1)*(r.P + r.N) / ((r.p + r.n + 2) * r.P);
     }
 };
 
-class LogicalSufficiency : public RuleQualityMeasure {
+class LogicalSufficiency : public MonotoneRuleQualityMeasure<LogicalSufficiency> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return (r.p * r.N) / (r.n * r.P);
     }
 };
 
-class MutualSupport : public RuleQualityMeasure {
+class MutualSupport : public MonotoneRuleQualityMeasure<MutualSupport> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return r.p / (r.n + r. P);
     }
 };
 
-class Correlation : public RuleQualityMeasure {
+class Correlation : public MonotoneRuleQualityMeasure<Correlation> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return (r.p * r.N - r.P * r.n) / sqrt(r.P * r.N * (r.p + r.n)*(r.P - r.p + r.N - r.n));
     }
 };
 
-class SBayesConfirmation : public RuleQualityMeasure {
+class SBayesConfirmation : public MonotoneRuleQualityMeasure<SBayesConfirmation> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         return r.p / (r.p + r.n) - (r.P - r.p) / (r.P - r.p + r.N - r.n);
     }
 };
 
-class C2 : public RuleQualityMeasure {
+class C2 : public MonotoneRuleQualityMeasure<C2> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         double first, second;
@@ -133,7 +170,7 @@ public:
     }
 };
 
-class CohenMeasure : public RuleQualityMeasure {
+class CohenMeasure : public MonotoneRuleQualityMeasure<CohenMeasure> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         double numerator, denominator;
@@ -143,7 +180,7 @@ public:
     }
 };
 
-class C1 : public RuleQualityMeasure {
+class C1 : public BatchRuleQualityMeasure<C1> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         double first, second;
@@ -169,7 +206,7 @@ public:
     static double ComputeQualityForTwoGroups(double p1, double n1, double p2, double n2);
 };
 
-class Cn2 : public RuleQualityMeasure {
+class Cn2 : public BatchRuleQualityMeasure<Cn2> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         double result = 2 * (r.p * log(r.p / ((r.p + r.n) * r.P / (r.P + r.N)))
@@ -180,7 +217,7 @@ public:
     }
 };
 
-class Gain : public RuleQualityMeasure {
+class Gain : public BatchRuleQualityMeasure<Gain> {
 public:
     double EvaluateRuleQualityFromResult(RuleEvaluationResult r) {
         double result = info(r.P, r.N) - info_pn(r);
@@ -201,25 +238,20 @@ private:
     }
 };
 
+/**
+ * Computes p-value of the rule (one-sided Fisher's exact test). Successive hypergeometric terms are computed
+ * from the ratio of neighbouring terms instead of evaluating each of them with lgamma; the summation stops
+ * when the remaining terms cannot change the result.
+ */
 class Pvalue : public RuleQualityMeasure {
 public:
-    double ComputePvalue(RuleEvaluationResult r, bool& warning) {
-        double suma = 0;
-        int upto = !(r.P - r.p < r.n) ? r.n : r.P - r.p;
-        for(int k = 0; k < upto; k++)
-            suma += prob(r.p + k, r.n - k, r.P, r.N);
-        if(r.P > (int)r.P || r.p > (int)r.p || r.N > (int)r.N || r.n > (int)r.n)
-            warning = true;
-        return suma;
-    }
+    Pvalue() : integral(false) {}
+    double ComputePvalue(RuleEvaluationResult r, bool& warning);
 private:
-    double prob(double p, double n, double P, double N)
-    {
-        return exp(
-                lgamma(p + n + 1) + lgamma(P + N - p - n + 1) + lgamma(P + 1) + lgamma(N + 1)
-                - lgamma(n + 1) - lgamma(p + 1) - lgamma(N - n + 1) - lgamma(P - p + 1) - lgamma(P + N + 1)
-                );
-    }
+    double logProb(double p, double n, double P, double N);
+    double logFactorial(double x);
+    std::vector<double> logFactorials;  /**< log(k!) for integer arguments, shared by all rules evaluated by the object*/
+    bool integral;                      /**< true if the current rule is evaluated on unweighted examples*/
 };
 #endif	/* RULEQUALITYMEASURE_H */
 
@@ -0,0 +1,239 @@
+#include "RuleSetCompaction.h"
+#include "RuleClassifier.h"
+#include <sstream>
+
+using namespace std;
+
+/**
+ * Compacts the rule set: normalizes the rules and removes the duplicate and subsumed ones.
+ * Of two duplicate rules the first one is kept.
+ * @param rules rule set (changed in place; the order of the remaining rules is kept)
+ * @param trainingSet training set of the rules; if given, rules are removed only if the predictions
+ * for its examples do not change
+ */
+void RuleSetCompaction::compact(list<Rule>& rules, SetOfExamples* trainingSet)
+{
+    vector<Rule*> ruleVector;
+    for (list<Rule>::iterator it = rules.begin(); it != rules.end(); it++)
+    {
+        removedConditions += normalize(*it);
+        ruleVector.push_back(&*it);
+    }
+    int numberOfRules = ruleVector.size();
+    vector<bool> removed(numberOfRules, false);
+
+    this->trainingSet = trainingSet;
+    if (trainingSet != NULL)
+    {
+        int size = trainingSet->size();
+        coveringRules.assign(size, vector<int>());
+        coveredExamples.assign(numberOfRules, vector<int>());
+        predictions.resize(size);
+        for (int i = 0; i < size; i++)
+        {
+            for (int r = 0; r < numberOfRules; r++)
+                if (ruleVector[r]->covers((*trainingSet)[i]))
+                {
+                    coveringRules[i].push_back(r);
+                    coveredExamples[r].push_back(i);
+                }
+            predictions[i] = predict(ruleVector, removed, i, -1);
+        }
+    }
+
+    for (int r = 0; r < numberOfRules; r++)
+    {
+        int general = -1;
+        bool duplicate = false;
+        for (int g = 0; g < numberOfRules && general == -1; g++)
+        {
+            if (g == r || removed[g] || ruleVector[g]->getDecisionClass() != ruleVector[r]->getDecisionClass()
+                    || !subsumes(*ruleVector[g], *ruleVector[r]))
+                continue;
+            duplicate = subsumes(*ruleVector[r], *ruleVector[g]);
+            if (!duplicate || g < r)
+                general = g;
+        }
+        if (general == -1)
+            continue;
+        if (trainingSet != NULL && !isPredictionKept(ruleVector, removed, r))
+        {
+            keptRules++;
+            continue;
+        }
+        removed[r] = true;
+        duplicate ? removedDuplicates++ : removedSubsumed++;
+    }
+
+    int r = 0;
+    for (list<Rule>::iterator it = rules.begin(); it != rules.end(); r++)
+        it = removed[r] ? rules.erase(it) : ++it;
+    coveringRules.clear();
+    coveredExamples.clear();
+    predictions.clear();
+}
+
+/**
+ * @return report of the changes of the rule set
+ */
+string RuleSetCompaction::toString() const
+{
+    ostringstream oss;
+    oss << "compaction: removed " << removedConditions << " redundant conditions, " << removedDuplicates
+        << " duplicate rules and " << removedSubsumed << " subsumed rules";
+    if (keptRules > 0)
+        oss << "; kept " << keptRules << " redundant rules changing the predictions for the training set";
+    return oss.str();
+}
+
+/**
+ * Normalizes conditions of the rule: on every attribute only the tightest lower and upper bounds
+ * and one of equal other conditions are left; the rule covers the same examples as before
+ * @param rule rule
+ * @return number of removed conditions
+ */
+int RuleSetCompaction::normalize(Rule& rule)
+{
+    int removed = 0;
+    vector<list<ElementaryCondition> >& conditions = rule.getConditions();
+    for (size_t i = 0; i < conditions.size(); i++)
+    {
+        if (conditions[i].size() < 2)
+            continue;
+        list<ElementaryCondition> normalized;
+        list<ElementaryCondition>::iterator lower = normalized.end(), upper = normalized.end();
+        for (list<ElementaryCondition>::iterator it = conditions[i].begin(); it != conditions[i].end(); it++)
+        {
+            ConditionKind kind = getKind(*it);
+            list<ElementaryCondition>::iterator& bound = kind == LOWER_BOUND ? lower : upper;
+            if (kind == OTHER_CONDITION)
+            {
+                if (find(normalized.begin(), normalized.end(), *it) == normalized.end())
+                    normalized.push_back(*it);
+            }
+            else if (bound == normalized.end())
+                bound = normalized.insert(normalized.end(), *it);
+            else if (isTighter(*it, *bound, kind))
+                *bound = *it;
+        }
+        removed += conditions[i].size() - normalized.size();
+        //the result of the evaluation stays valid, the rule covers the same examples
+        conditions[i].swap(normalized);
+    }
+    return removed;
+}
+
+/**
+ * Checks if one rule is subsumed by another one: every example covered by the specific rule is
+ * covered by the general one, as every condition of the general rule follows from the conditions
+ * of the specific rule on the same attribute. Decision classes are not compared.
+ * @param general general rule
+ * @param specific specific rule
+ * @return true if the specific rule is subsumed by the general one
+ */
+bool RuleSetCompaction::subsumes(Rule& general, Rule& specific)
+{
+    vector<list<ElementaryCondition> >& generalConditions = general.getConditions();
+    vector<list<ElementaryCondition> >& specificConditions = specific.getConditions();
+    for (size_t i = 0; i < generalConditions.size(); i++)
+        for (list<ElementaryCondition>::iterator it = generalConditions[i].begin(); it != generalConditions[i].end(); it++)
+            if (i >= specificConditions.size() || !implies(specificConditions[i], *it))
+                return false;
+    return true;
+}
+
+RuleSetCompaction::ConditionKind RuleSetCompaction::getKind(const ElementaryCondition& condition)
+{
+    const type_info& type = typeid(*condition.getOperator());
+    if (type == typeid(GreaterEqualOperator) || type == typeid(GreaterThanOperator))
+        return LOWER_BOUND;
+    if (type == typeid(LessThanOperator) || type == typeid(LessEqualOperator))
+        return UPPER_BOUND;
+    return OTHER_CONDITION;
+}
+
+/**
+ * @return true for the bounds which exclude their value ("<" and ">")
+ */
+bool RuleSetCompaction::isStrict(const ElementaryCondition& condition)
+{
+    const type_info& type = typeid(*condition.getOperator());
+    return type == typeid(GreaterThanOperator) || type == typeid(LessThanOperator);
+}
+
+/**
+ * @param first bound
+ * @param second bound of the same kind
+ * @param kind kind of the bounds
+ * @return true if the first bound is satisfied by a subset of the values satisfying the second one
+ */
+bool RuleSetCompaction::isTighter(const ElementaryCondition& first, const ElementaryCondition& second, ConditionKind kind)
+{
+    double a = first.getAttributeValue(), b = second.getAttributeValue();
+    if (a == b)
+        return isStrict(first) || !isStrict(second);
+    return kind == LOWER_BOUND ? a > b : a < b;
+}
+
+/**
+ * Checks if the condition follows from the conditions on the same attribute (missing values
+ * satisfy no condition, so it does not follow from an empty list)
+ * @param conditions conditions on the attribute
+ * @param condition condition
+ * @return true if every value satisfying all the conditions satisfies the condition
+ */
+bool RuleSetCompaction::implies(list<ElementaryCondition>& conditions, ElementaryCondition& condition)
+{
+    ConditionKind kind = getKind(condition);
+    bool inequality = typeid(*condition.getOperator()) == typeid(InequalityOperator);
+    for (list<ElementaryCondition>::iterator it = conditions.begin(); it != conditions.end(); it++)
+    {
+        if (*it == condition)
+            return true;
+        ConditionKind itKind = getKind(*it);
+        if (kind != OTHER_CONDITION && itKind == kind && isTighter(*it, condition, kind))
+            return true;
+        //a condition satisfied by one value only
+        if (kind != OTHER_CONDITION && typeid(*it->getOperator()) == typeid(EqualityOperator)
+                && condition.isSatisfied(it->getAttributeValue()))
+            return true;
+        //"!= v" follows from any condition excluding v
+        if (inequality && !it->isSatisfied(condition.getAttributeValue()))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Predicts the class of a training example by the rules which are not removed, as RuleClassifier does
+ * @param rules rules
+ * @param removed true for the removed rules
+ * @param example index of the example in the training set
+ * @param excludedRule index of a rule left out (-1 if none)
+ * @return predicted class
+ */
+double RuleSetCompaction::predict(vector<Rule*>& rules, vector<bool>& removed, int example, int excludedRule)
+{
+    voting.clear();
+    for (vector<int>::iterator it = coveringRules[example].begin(); it != coveringRules[example].end(); it++)
+        if (*it != excludedRule && !removed[*it])
+            voting.push_back(rules[*it]);
+    return RuleClassifier::classify(voting);
+}
+
+/**
+ * @param rules rules
+ * @param removed true for the removed rules
+ * @param ruleIndex index of the rule
+ * @return true if the predictions for the training examples do not change without the rule
+ */
+bool RuleSetCompaction::isPredictionKept(vector<Rule*>& rules, vector<bool>& removed, int ruleIndex)
+{
+    for (vector<int>::iterator it = coveredExamples[ruleIndex].begin(); it != coveredExamples[ruleIndex].end(); it++)
+    {
+        double prediction = predict(rules, removed, *it, ruleIndex);
+        if (prediction != predictions[*it] && (prediction == prediction || predictions[*it] == predictions[*it]))
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef RULESETCOMPACTION_H
+#define	RULESETCOMPACTION_H
+
+#include "Rule.h"
+#include "SetOfExamples.h"
+#include "ElementaryCondition.h"
+#include <list>
+#include <vector>
+#include <string>
+
+/**
+ * Compaction of an induced rule set, so the model is smaller and faster to apply:
+ *  - conditions of every rule are normalized to at most one lower and one upper bound (one interval)
+ *    per attribute and distinct other conditions; the rule covers the same examples as before,
+ *  - rules which are duplicates of other rules of the same class or are subsumed by them (the conditions
+ *    of the other rule follow from the conditions of the rule) are removed.
+ * Removing a rule removes its vote from the classification of the examples it covers, so if the training
+ * set is given, a rule is removed only if the predictions for all the training examples stay the same.
+ */
+class RuleSetCompaction
+{
+public:
+    RuleSetCompaction() : removedConditions(0), removedDuplicates(0), removedSubsumed(0), keptRules(0) {}
+    void compact(std::list<Rule>& rules, SetOfExamples* trainingSet = NULL);
+    int getNumberOfRemovedConditions() const { return removedConditions; }
+    int getNumberOfRemovedDuplicates() const { return removedDuplicates; }
+    int getNumberOfRemovedSubsumed() const { return removedSubsumed; }
+    /** @return number of redundant rules kept, because their removal would change the training predictions*/
+    int getNumberOfKeptRules() const { return keptRules; }
+    std::string toString() const;
+
+    static int normalize(Rule& rule);
+    static bool subsumes(Rule& general, Rule& specific);
+private:
+    enum ConditionKind
+    {
+        LOWER_BOUND,
+        UPPER_BOUND,
+        OTHER_CONDITION
+    };
+
+    static ConditionKind getKind(const ElementaryCondition& condition);
+    static bool isStrict(const ElementaryCondition& condition);
+    static bool isTighter(const ElementaryCondition& first, const ElementaryCondition& second, ConditionKind kind);
+    static bool implies(std::list<ElementaryCondition>& conditions, ElementaryCondition& condition);
+    double predict(std::vector<Rule*>& rules, std::vector<bool>& removed, int example, int excludedRule);
+    bool isPredictionKept(std::vector<Rule*>& rules, std::vector<bool>& removed, int ruleIndex);
+
+    std::vector<std::vector<int> > coveringRules;   /**< indices of the rules covering every training example*/
+    std::vector<std::vector<int> > coveredExamples; /**< indices of the training examples covered by every rule*/
+    std::vector<double> predictions;                /**< predictions of the full rule set for the training examples*/
+    std::vector<const Rule*> voting;                /**< rules voting for the class of an example in predict*/
+    SetOfExamples* trainingSet;
+    int removedConditions;
+    int removedDuplicates;
+    int removedSubsumed;
+    int keptRules;
+};
+
+#endif	/* RULESETCOMPACTION_H */
@@ -9,6 +9,7 @@ using namespace std;
  */
 SetOfExamples::SetOfExamples(DataSet& ds, bool init) : dataset(&ds)
 {
+    IndexBufferPool::acquire(examples);
     if (!init) return;
     unsigned int size = dataset->getExamples().size();
     examples.resize(size);
@@ -18,7 +19,9 @@ SetOfExamples::SetOfExamples(DataSet& ds, bool init) : dataset(&ds)
 
 SetOfExamples::SetOfExamples(const SetOfExamples& orig)
 {
+    IndexBufferPool::acquire(examples);
     examples = orig.examples;
+    weightScales = orig.weightScales;
     dataset = orig.dataset;
 }
 
@@ -47,6 +50,17 @@ SetOfExamples& SetOfExamples::operator =(const SetOfExamples& orig)
     if (&orig == this)
         return *this;
     examples = orig.examples;
+    weightScales = orig.weightScales;
+    dataset = orig.dataset;
+    return *this;
+}
+
+SetOfExamples& SetOfExamples::operator =(SetOfExamples&& orig) noexcept
+{
+    if (&orig == this)
+        return *this;
+    examples.swap(orig.examples);   //the old buffer is released (or reused) together with orig
+    weightScales.swap(orig.weightScales);
     dataset = orig.dataset;
     return *this;
 }
@@ -60,9 +74,28 @@ SetOfExamples SetOfExamples::operator-(SetOfExamples& second)
 {
     SetOfExamples result;
     result.dataset = dataset;
-    sort(examples.begin(), examples.end());
     sort(second.examples.begin(), second.examples.end());
-    set_difference(examples.begin(), examples.end(), second.examples.begin(), second.examples.end(), back_inserter(result.examples));
+    if (weightScales.empty())
+    {
+        sort(examples.begin(), examples.end());
+        set_difference(examples.begin(), examples.end(), second.examples.begin(), second.examples.end(), back_inserter(result.examples));
+        return result;
+    }
+    //scales of the weights are kept with the examples
+    vector<pair<int, double> > scaled;
+    for (unsigned int i = 0; i < examples.size(); i++)
+        scaled.push_back(make_pair(examples[i], weightScales[i]));
+    sort(scaled.begin(), scaled.end());
+    for (unsigned int i = 0; i < scaled.size(); i++)
+    {
+        examples[i] = scaled[i].first;
+        weightScales[i] = scaled[i].second;
+        if (!binary_search(second.examples.begin(), second.examples.end(), scaled[i].first))
+        {
+            result.examples.push_back(scaled[i].first);
+            result.weightScales.push_back(scaled[i].second);
+        }
+    }
     return result;
 }
 
@@ -82,12 +115,11 @@ string SetOfExamples::toString()
 SetOfExamples SetOfExamples::getExamplesForDecAtt(double decAttVal)
 {
     SetOfExamples result;
-    vector<int>::iterator it;
     result.dataset = dataset;
-    for (it = examples.begin(); it != examples.end(); it++)
+    for (unsigned int i = 0; i < examples.size(); i++)
     {
-        if (((*dataset)[*it].getDecisionAttribute()) == decAttVal)
-            result.examples.push_back(*it);
+        if (((*dataset)[examples[i]].getDecisionAttribute()) == decAttVal)
+            result.addExample(*this, i);
     }
     return result;
 }
@@ -109,7 +141,22 @@ Attribute::AttributeType SetOfExamples::getAttributeType(int index)
  */
 void SetOfExamples::addExample(SetOfExamples& second, int index)
 {
+    if (!second.weightScales.empty() && weightScales.empty())
+        weightScales.resize(examples.size(), 1);
     examples.push_back(second.examples[index]);
+    if (!weightScales.empty())
+        weightScales.push_back(second.weightScales.empty() ? 1 : second.weightScales[index]);
+}
+
+/**
+ * Removes the example from the set
+ * @param index index of the example in the set
+ */
+void SetOfExamples::removeExample(int index)
+{
+    examples.erase(examples.begin() + index);
+    if (!weightScales.empty())
+        weightScales.erase(weightScales.begin() + index);
 }
 
 /**
@@ -147,10 +194,24 @@ int SetOfExamples::getAllClassesCount()
 
 /**
  * Shuffles the set of examples
+ * @param random random number generator
  */
-void SetOfExamples::shuffle()
+void SetOfExamples::shuffle(RandomGenerator& random)
 {
-    random_shuffle(examples.begin(), examples.end(), [](ptrdiff_t i) { return rand()%i;});
+    if (weightScales.empty())
+    {
+        random_shuffle(examples.begin(), examples.end(), [&random](ptrdiff_t i) { return random.nextInt(i);});
+        return;
+    }
+    vector<pair<int, double> > scaled;
+    for (unsigned int i = 0; i < examples.size(); i++)
+        scaled.push_back(make_pair(examples[i], weightScales[i]));
+    random_shuffle(scaled.begin(), scaled.end(), [&random](ptrdiff_t i) { return random.nextInt(i);});
+    for (unsigned int i = 0; i < scaled.size(); i++)
+    {
+        examples[i] = scaled[i].first;
+        weightScales[i] = scaled[i].second;
+    }
 }
 
 /**
@@ -158,9 +219,10 @@ void SetOfExamples::shuffle()
  * Distribution of the decision attribute is kept in each fold (stratified sampling)
  * @param nfolds number of folds
  * @param everyClassInFold indicates whether there should be examples from all decision classes in every fold
+ * @param random random number generator
  * @return vector of nfold set of examples
  */
-vector<SetOfExamples> SetOfExamples::createStratifiedFolds(unsigned int nfolds, bool everyClassInFold) throw (RulesInductionException)
+vector<SetOfExamples> SetOfExamples::createStratifiedFolds(unsigned int nfolds, bool everyClassInFold, RandomGenerator& random) throw (RulesInductionException)
 {
     if (nfolds > examples.size() || nfolds <= 1)
         throw RulesInductionException("Number of folds cannot be less than two or more than number of examples");
@@ -171,7 +233,7 @@ vector<SetOfExamples> SetOfExamples::createStratifiedFolds(unsigned int nfolds,
     for (unsigned int i = 0; i < classes.size(); i++)
     {
         SetOfExamples exOfClass(getExamplesForDecAtt(classes[i]));
-        exOfClass.shuffle();
+        exOfClass.shuffle(random);
         classSize = exOfClass.size();
         if(!everyClassInFold || classSize >= nfolds)
             for (unsigned int j = 0; j < classSize; j++)
@@ -186,11 +248,73 @@ vector<SetOfExamples> SetOfExamples::createStratifiedFolds(unsigned int nfolds,
 
 double SetOfExamples::getSumOfWeights()
 {
+    if (hasUnitWeights())
+        return examples.size();
     double sumOfWeights = 0;
-    vector<int>::iterator it;
-    for (it = examples.begin(); it != examples.end(); it++)
+    int size = examples.size();
+    for (int i = 0; i < size; i++)
     {
-        sumOfWeights += (*dataset)[*it].getWeight();
+        sumOfWeights += getWeight(i);
     }
     return sumOfWeights;
 }
+
+/**
+ * Draws a sample for the growth of a rule. All the examples of the positive class are kept
+ * and at most maxNegatives other examples are chosen at random (the order of the set is kept).
+ * Weights of the chosen negative examples are scaled, so that their sum is equal to the sum
+ * of weights of all the negative examples of the set.
+ * @param decClass positive class value
+ * @param maxNegatives maximal number of negative examples in the sample
+ * @param random random number generator
+ * @return sample; copy of the set if it doesn't have more than maxNegatives negative examples
+ * or if the weights of all the chosen negative examples are zero
+ */
+SetOfExamples SetOfExamples::sampleNegatives(double decClass, int maxNegatives, RandomGenerator& random)
+{
+    int size = examples.size(), negatives = 0;
+    double negativeWeight = 0;
+    for (int i = 0; i < size; i++)
+        if ((*dataset)[examples[i]].getDecisionAttribute() != decClass)
+        {
+            negatives++;
+            negativeWeight += getWeight(i);
+        }
+    if (negatives <= maxNegatives)
+        return *this;
+
+    SetOfExamples result(*dataset);
+    result.examples.reserve(size - negatives + maxNegatives);
+    result.weightScales.reserve(size - negatives + maxNegatives);
+    int needed = maxNegatives, left = negatives;
+    double sampledWeight = 0;
+    for (int i = 0; i < size; i++)
+    {
+        double scale = weightScales.empty() ? 1 : weightScales[i];
+        if ((*dataset)[examples[i]].getDecisionAttribute() == decClass)
+        {
+            result.examples.push_back(examples[i]);
+            result.weightScales.push_back(scale);
+        }
+        else
+        {
+            //selection sampling: every subset of maxNegatives negative examples is equally probable
+            if (random.nextDouble() * left < needed)
+            {
+                result.examples.push_back(examples[i]);
+                result.weightScales.push_back(scale);
+                sampledWeight += getWeight(i);
+                needed--;
+            }
+            left--;
+        }
+    }
+    //the weight of the negative examples cannot be restored from a sample without weight
+    if (!(sampledWeight > 0))
+        return *this;
+    double factor = negativeWeight / sampledWeight;
+    for (unsigned int i = 0; i < result.examples.size(); i++)
+        if ((*dataset)[result.examples[i]].getDecisionAttribute() != decClass)
+            result.weightScales[i] *= factor;
+    return result;
+}
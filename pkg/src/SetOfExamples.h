@@ -10,7 +10,9 @@
 #include "Attribute.h"
 #include "Example.h"
 #include "DataSet.h"
+#include "MemoryPool.h"
 #include "RulesInductionException.h"
+#include "RandomGenerator.h"
 
 /**
  * Represents set of examples and provides methods for operating on it.
@@ -21,10 +23,20 @@ class SetOfExamples {
 public:
     SetOfExamples(DataSet& ds, bool init = false);
     SetOfExamples(const SetOfExamples& orig);
+    SetOfExamples(SetOfExamples&& orig) noexcept : examples(std::move(orig.examples)),
+        weightScales(std::move(orig.weightScales)), dataset(orig.dataset) {}
+    ~SetOfExamples() { IndexBufferPool::release(examples); }
     SetOfExamples& operator=(const SetOfExamples&);
+    SetOfExamples& operator=(SetOfExamples&&) noexcept;
     SetOfExamples operator-(SetOfExamples&);
     int size() { return examples.size(); }
     Example& operator[](int i);
+    int getIndex(int i) const { return examples[i]; }
+    /** weight of the example; in a sample it is scaled to represent the examples left out*/
+    double getWeight(int i) { return weightScales.empty() ? (*dataset)[examples[i]].getWeight()
+                                                          : (*dataset)[examples[i]].getWeight() * weightScales[i]; }
+    /** @return true if every example of the set has weight 1 (see UnitWeights)*/
+    bool hasUnitWeights() { return weightScales.empty() && dataset->hasUnitWeights(); }
 
     //list<Example>& getExamples() ;
     //vector<double> getDecisionAttributes() ;
@@ -37,14 +49,16 @@ public:
     Attribute::AttributeType getAttributeType(int);
     DataSet& getDataSet() { return *dataset; }
     void addExample(SetOfExamples& second, int index);
-    void removeExample(int index) { examples.erase(examples.begin() + index); }
-    void clear() { examples.clear(); }
-    void shuffle();
-    std::vector<SetOfExamples> createStratifiedFolds(unsigned int nfolds, bool everyClassInFold) throw(RulesInductionException);
+    void removeExample(int index);
+    void clear() { examples.clear(); weightScales.clear(); }
+    void shuffle(RandomGenerator& random);
+    std::vector<SetOfExamples> createStratifiedFolds(unsigned int nfolds, bool everyClassInFold, RandomGenerator& random) throw(RulesInductionException);
     double getSumOfWeights();
+    SetOfExamples sampleNegatives(double decClass, int maxNegatives, RandomGenerator& random);
 private:
-    SetOfExamples(){};
+    SetOfExamples() { IndexBufferPool::acquire(examples); }
     std::vector<int> examples;	//indices in data set
+    std::vector<double> weightScales;	//factors of the weights of the examples in a sample, empty if weights are not scaled
     DataSet* dataset;
 };
 
@@ -0,0 +1,41 @@
+#include "SparseColumn.h"
+#include <limits>
+
+using namespace std;
+
+/**
+ * Creates the column from all its values
+ * @param values values of the rows
+ * @param size number of rows
+ * @param defaultValue value which is not stored
+ */
+SparseColumn::SparseColumn(const double* values, size_t size, double defaultValue) : defaultValue(defaultValue), size(size)
+{
+    for (size_t i = 0; i < size; i++)
+        if (!isDefault(values[i], defaultValue))
+        {
+            rows.push_back(i);
+            this->values.push_back(values[i]);
+        }
+}
+
+/**
+ * Chooses the default value of a sparse column: zero or missing value, whichever is more frequent
+ * @param values values of the rows
+ * @param size number of rows
+ * @param numberOfOthers number of rows with values other than the chosen one (output)
+ * @return default value
+ */
+double SparseColumn::chooseDefaultValue(const double* values, size_t size, size_t& numberOfOthers)
+{
+    size_t zeros = 0, missing = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (values[i] == 0)
+            zeros++;
+        else if (values[i] != values[i])
+            missing++;
+    }
+    numberOfOthers = size - max(zeros, missing);
+    return zeros >= missing ? 0.0 : numeric_limits<double>::quiet_NaN();
+}
@@ -0,0 +1,48 @@
+#ifndef SPARSECOLUMN_H
+#define	SPARSECOLUMN_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * Column of a numerical attribute with mostly one (default) value, usually zero or missing.
+ * Only the rows with other values are stored, with their values (compressed sparse column);
+ * the default value of the other rows is implicit. Negative zeros are stored as zeros.
+ */
+class SparseColumn
+{
+public:
+    SparseColumn(const double* values, std::size_t size, double defaultValue);
+    double getDefaultValue() const { return defaultValue; }
+    /** @return sorted indices of the rows with values other than the default one*/
+    const std::vector<int>& getRows() const { return rows; }
+    /** @return values of the rows returned by getRows()*/
+    const std::vector<double>& getValues() const { return values; }
+    std::size_t getNumberOfRows() const { return size; }
+    std::size_t getMemoryUsage() const { return rows.size() * (sizeof(int) + sizeof(double)); }
+
+    /**
+     * @param row index of the row
+     * @return value of the row
+     */
+    double getValue(std::size_t row) const
+    {
+        std::vector<int>::const_iterator it = std::lower_bound(rows.begin(), rows.end(), (int)row);
+        return it != rows.end() && *it == (int)row ? values[it - rows.begin()] : defaultValue;
+    }
+
+    /** @return true if the value is the default one (NaN is the default value if the default is NaN)*/
+    static bool isDefault(double value, double defaultValue)
+    {
+        return value == defaultValue || (value != value && defaultValue != defaultValue);
+    }
+    static double chooseDefaultValue(const double* values, std::size_t size, std::size_t& numberOfOthers);
+private:
+    std::vector<int> rows;
+    std::vector<double> values;
+    double defaultValue;
+    std::size_t size;
+};
+
+#endif	/* SPARSECOLUMN_H */
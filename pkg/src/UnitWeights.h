@@ -0,0 +1,20 @@
+#ifndef UNITWEIGHTS_H
+#define	UNITWEIGHTS_H
+
+#include "SetOfExamples.h"
+
+/**
+ * Weights of the examples of a set without weights (see SetOfExamples::hasUnitWeights): every weight
+ * is one, so the kernels count the examples with integers and never read the weights.
+ * The counts are the same as the sums of the weights, which are exact for such sets.
+ */
+class UnitWeights
+{
+public:
+    typedef int Count;
+
+    explicit UnitWeights(SetOfExamples&) {}
+    int operator()(int) const { return 1; }
+};
+
+#endif	/* UNITWEIGHTS_H */